@@ -10,6 +10,7 @@
 #include <AL/alc.h>
 #include <AL/efx.h>
 #include <AL/efx-presets.h>
+#include <AL/alext.h>
 #define HAS_EFX
 #endif
 #endif
@@ -52,6 +53,13 @@ namespace
 	LPALGETAUXILIARYEFFECTSLOTFV alGetAuxiliaryEffectSlotfv = nullptr;
 }
 #endif
+#if defined(VI_OPENAL) && defined(ALC_SOFT_loopback)
+namespace
+{
+	LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT = nullptr;
+	LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT = nullptr;
+}
+#endif
 #define return_error_if do { auto __error = audio_exception(); if (__error.has_error()) return __error; else return core::expectation::met; } while (0)
 #define return_error_if_dev(device) do { auto __error = audio_exception(device); if (__error.has_error()) return __error; else return core::expectation::met; } while (0)
 
@@ -193,6 +201,22 @@ namespace vitex
 		{
 #if defined(VI_OPENAL) && defined(HAS_EFX)
 			alEffectfv(filter, (uint32_t)value, FS);
+#endif
+			return_error_if;
+		}
+		expects_audio<void> audio_context::set_effect_slot1i(uint32_t slot, effect_ex value, int F1)
+		{
+#if defined(VI_OPENAL) && defined(HAS_EFX)
+			if (alAuxiliaryEffectSloti != nullptr)
+				alAuxiliaryEffectSloti(slot, (uint32_t)value, F1);
+#endif
+			return_error_if;
+		}
+		expects_audio<void> audio_context::set_effect_slot1f(uint32_t slot, effect_ex value, float F1)
+		{
+#if defined(VI_OPENAL) && defined(HAS_EFX)
+			if (alAuxiliaryEffectSlotf != nullptr)
+				alAuxiliaryEffectSlotf(slot, (uint32_t)value, F1);
 #endif
 			return_error_if;
 		}
@@ -380,6 +404,19 @@ namespace vitex
 			return 0;
 #endif
 		}
+		uint32_t audio_context::get_max_sends()
+		{
+#if defined(VI_OPENAL) && defined(HAS_EFX)
+			ALCcontext* context = alcGetCurrentContext();
+			ALCdevice* device = context ? alcGetContextsDevice(context) : nullptr;
+			ALCint count = 0;
+			if (device != nullptr)
+				alcGetIntegerv(device, ALC_MAX_AUXILIARY_SENDS, 1, &count);
+			return (uint32_t)std::max<ALCint>(count, 0);
+#else
+			return 0;
+#endif
+		}
 
 		audio_filter::audio_filter() noexcept
 		{
@@ -471,9 +508,10 @@ namespace vitex
 		}
 		expects_audio<void> audio_effect::bind(audio_source* new_source, int new_zone)
 		{
-			VI_ASSERT(source != nullptr, "source should not be empty");
 			source = new_source;
 			zone = new_zone;
+			if (!source)
+				return core::expectation::met;
 #if defined(VI_OPENAL) && defined(HAS_EFX)
 			alSource3i(source->get_instance(), AL_AUXILIARY_SEND_FILTER, (ALint)slot, zone, (ALint)(filter ? filter->filter : AL_FILTER_NULL));
 #endif
@@ -481,7 +519,8 @@ namespace vitex
 		}
 		expects_audio<void> audio_effect::unbind()
 		{
-			VI_ASSERT(source != nullptr, "source should not be empty");
+			if (!source)
+				return core::expectation::met;
 #if defined(VI_OPENAL) && defined(HAS_EFX)
 			alSource3i(source->get_instance(), AL_AUXILIARY_SEND_FILTER, AL_EFFECTSLOT_NULL, zone, AL_FILTER_NULL);
 #endif
@@ -496,6 +535,82 @@ namespace vitex
 			return source;
 		}
 
+		audio_bus::audio_bus(const std::string_view& new_name, audio_effect* new_effect) noexcept : name(new_name), effect(new_effect)
+		{
+			VI_ASSERT(effect != nullptr, "effect should be set");
+		}
+		audio_bus::~audio_bus() noexcept
+		{
+			core::memory::release(effect);
+		}
+		expects_audio<void> audio_bus::synchronize(const trigonometry::vector3& listener)
+		{
+			if (dirty)
+			{
+				VI_TRACE("[audio] synchronize %s bus", name.c_str());
+				auto status = effect->synchronize();
+				if (!status)
+					return status;
+
+				status = audio_context::set_effect_slot1i(effect->slot, effect_ex::effect_slot_effect, (int)effect->effect);
+				if (!status)
+					return status;
+
+				dirty = false;
+			}
+
+			float target = gain * get_zone_gain(listener);
+			if (std::abs(target - applied_gain) <= std::numeric_limits<float>::epsilon())
+				return core::expectation::met;
+
+			applied_gain = target;
+			return audio_context::set_effect_slot1f(effect->slot, effect_ex::effect_slot_gain, target);
+		}
+		void audio_bus::set_zone(const trigonometry::vector3& new_center, float new_radius, float new_falloff)
+		{
+			center = new_center;
+			radius = std::max(0.0f, new_radius);
+			falloff = std::max(0.0f, new_falloff);
+		}
+		void audio_bus::set_gain(float value)
+		{
+			gain = std::max(0.0f, value);
+		}
+		void audio_bus::invalidate()
+		{
+			dirty = true;
+		}
+		float audio_bus::get_zone_gain(const trigonometry::vector3& listener) const
+		{
+			if (!is_zone())
+				return 1.0f;
+
+			float distance = center.distance(listener);
+			if (distance <= radius)
+				return 1.0f;
+
+			if (falloff <= 0.0f)
+				return 0.0f;
+
+			return std::max(0.0f, 1.0f - (distance - radius) / falloff);
+		}
+		float audio_bus::get_gain() const
+		{
+			return gain;
+		}
+		audio_effect* audio_bus::get_effect() const
+		{
+			return effect;
+		}
+		const core::string& audio_bus::get_name() const
+		{
+			return name;
+		}
+		bool audio_bus::is_zone() const
+		{
+			return radius > 0.0f || falloff > 0.0f;
+		}
+
 		audio_clip::audio_clip(int buffer_count, int new_format) noexcept : format(new_format)
 		{
 			if (buffer_count > 0)
@@ -571,6 +686,7 @@ namespace vitex
 		}
 		audio_source::~audio_source() noexcept
 		{
+			remove_sends();
 			remove_effects();
 			core::memory::release(clip);
 #ifdef VI_OPENAL
@@ -585,11 +701,14 @@ namespace vitex
 			VI_ASSERT(effect != nullptr, "effect should be set");
 			effect->bind(this, (int)effects.size());
 			effects.push_back(effect);
+			if (!sends.empty())
+				route_sends();
 			return effects.size() - 1;
 		}
 		expects_audio<void> audio_source::remove_effect(size_t effect_id)
 		{
 			VI_ASSERT(effect_id < effects.size(), "index outside of range");
+			size_t previous_effects = effects.size();
 			auto it = effects.begin() + effect_id;
 			core::memory::release(*it);
 			effects.erase(it);
@@ -601,6 +720,9 @@ namespace vitex
 				effect->bind(this, (int)i);
 			}
 
+			if (!sends.empty())
+				return route_sends(previous_effects);
+
 			return_error_if;
 		}
 		expects_audio<void> audio_source::remove_effect_by_id(uint64_t effect_id)
@@ -615,10 +737,94 @@ namespace vitex
 		}
 		expects_audio<void> audio_source::remove_effects()
 		{
+			size_t previous_effects = effects.size();
 			for (auto* effect : effects)
 				core::memory::release(effect);
 
 			effects.clear();
+			if (!sends.empty())
+				return route_sends(previous_effects);
+
+			return_error_if;
+		}
+		expects_audio<void> audio_source::set_send(audio_bus* bus, float gain)
+		{
+			VI_ASSERT(bus != nullptr, "bus should be set");
+			gain = std::max(0.0f, gain);
+			for (auto& send : sends)
+			{
+				if (send.bus != bus)
+					continue;
+
+				if (std::abs(send.gain - gain) <= std::numeric_limits<float>::epsilon())
+					return core::expectation::met;
+
+				send.gain = gain;
+				((filters::lowpass*)send.filter)->gain = gain;
+				send.filter->synchronize();
+				return route_sends();
+			}
+
+			filters::lowpass* filter = new filters::lowpass();
+			filter->gain = gain;
+			filter->synchronize();
+
+			audio_send send;
+			send.bus = bus;
+			send.filter = filter;
+			send.gain = gain;
+			sends.push_back(send);
+			bus->add_ref();
+			return route_sends();
+		}
+		expects_audio<void> audio_source::remove_send(audio_bus* bus)
+		{
+			for (auto it = sends.begin(); it != sends.end(); ++it)
+			{
+				if (it->bus != bus)
+					continue;
+#if defined(VI_OPENAL) && defined(HAS_EFX)
+				size_t index = effects.size() + sends.size() - 1;
+				if (index < audio_context::get_max_sends())
+					alSource3i(instance, AL_AUXILIARY_SEND_FILTER, AL_EFFECTSLOT_NULL, (ALint)index, AL_FILTER_NULL);
+#endif
+				core::memory::release(it->filter);
+				core::memory::release(it->bus);
+				sends.erase(it);
+				return route_sends();
+			}
+
+			return core::expectation::met;
+		}
+		expects_audio<void> audio_source::remove_sends()
+		{
+			for (size_t i = 0; i < sends.size(); i++)
+			{
+				auto& send = sends[i];
+#if defined(VI_OPENAL) && defined(HAS_EFX)
+				if (effects.size() + i < audio_context::get_max_sends())
+					alSource3i(instance, AL_AUXILIARY_SEND_FILTER, AL_EFFECTSLOT_NULL, (ALint)(effects.size() + i), AL_FILTER_NULL);
+#endif
+				core::memory::release(send.filter);
+				core::memory::release(send.bus);
+			}
+
+			sends.clear();
+			return_error_if;
+		}
+		expects_audio<void> audio_source::route_sends(size_t previous_effects)
+		{
+#if defined(VI_OPENAL) && defined(HAS_EFX)
+			size_t limit = audio_context::get_max_sends();
+			for (size_t i = effects.size() + sends.size(); i < std::min(limit, previous_effects + sends.size()); i++)
+				alSource3i(instance, AL_AUXILIARY_SEND_FILTER, AL_EFFECTSLOT_NULL, (ALint)i, AL_FILTER_NULL);
+
+			for (size_t i = 0; i < sends.size() && effects.size() + i < limit; i++)
+			{
+				auto& send = sends[i];
+				alSource3i(instance, AL_AUXILIARY_SEND_FILTER, (ALint)send.bus->effect->slot, (ALint)(effects.size() + i), (ALint)send.filter->filter);
+			}
+#endif
 			return_error_if;
 		}
 		expects_audio<void> audio_source::set_clip(audio_clip* new_clip)
@@ -738,6 +944,10 @@ namespace vitex
 		{
 			return effects.size();
 		}
+		size_t audio_source::get_sends_count() const
+		{
+			return sends.size();
+		}
 		audio_clip* audio_source::get_clip() const
 		{
 			return clip;
@@ -775,10 +985,36 @@ namespace vitex
 			alcMakeContextCurrent((ALCcontext*)context);
 			alDistanceModel(AL_LINEAR_DISTANCE);
 			alListenerf(AL_GAIN, 0.0f);
+#endif
+		}
+		audio_device::audio_device(uint32_t render_frequency, uint32_t render_channels) noexcept : frequency(render_frequency), channels(render_channels == 1 ? 1 : 2), loopback(true)
+		{
+#if defined(VI_OPENAL) && defined(ALC_SOFT_loopback)
+			alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT");
+			alcRenderSamplesSOFT = (LPALCRENDERSAMPLESSOFT)alcGetProcAddress(nullptr, "alcRenderSamplesSOFT");
+			VI_PANIC(alcLoopbackOpenDeviceSOFT != nullptr && alcRenderSamplesSOFT != nullptr, "audio loopback device is not supported");
+
+			device = (void*)alcLoopbackOpenDeviceSOFT(nullptr);
+			VI_TRACE("[audio] open alc loopback device: 0x%" PRIXPTR, (void*)device);
+			VI_PANIC(device != nullptr, "audio loopback device cannot be created [ %s ]", alGetString(alGetError()));
+
+			ALCint attributes[] = { ALC_FORMAT_CHANNELS_SOFT, channels == 1 ? ALC_MONO_SOFT : ALC_STEREO_SOFT, ALC_FORMAT_TYPE_SOFT, ALC_FLOAT_SOFT, ALC_FREQUENCY, (ALCint)frequency, 0 };
+			context = (void*)alcCreateContext((ALCdevice*)device, attributes);
+			VI_TRACE("[audio] create alc loopback context: 0x%" PRIXPTR " (%i hz, %i channels)", (void*)context, (int)frequency, (int)channels);
+			VI_PANIC(context != nullptr, "audio loopback context cannot be created [ %s ]", alcGetString((ALCdevice*)device, alcGetError((ALCdevice*)device)));
+
+			alcMakeContextCurrent((ALCcontext*)context);
+			alDistanceModel(AL_LINEAR_DISTANCE);
+			alListenerf(AL_GAIN, 0.0f);
+#else
+			VI_PANIC(false, "audio loopback device is not supported");
 #endif
 		}
 		audio_device::~audio_device() noexcept
 		{
+			for (auto& bus : buses)
+				core::memory::release(bus.second);
+			buses.clear();
 #ifdef VI_OPENAL
 			if (context != nullptr)
 			{
@@ -949,6 +1185,85 @@ namespace vitex
 #endif
 			return_error_if_dev(device);
 		}
+		expects_audio<void> audio_device::synchronize_buses(const trigonometry::vector3& listener)
+		{
+			for (auto& bus : buses)
+			{
+				auto status = bus.second->synchronize(listener);
+				if (!status)
+					return status;
+			}
+
+			return core::expectation::met;
+		}
+		audio_bus* audio_device::add_bus(const std::string_view& name, audio_effect* effect)
+		{
+			VI_ASSERT(effect != nullptr, "effect should be set");
+			VI_TRACE("[audio] add %.*s bus", (int)name.size(), name.data());
+			auto& bus = buses[core::string(name)];
+			core::memory::release(bus);
+			bus = new audio_bus(name, effect);
+			return bus;
+		}
+		audio_bus* audio_device::get_bus(const std::string_view& name) const
+		{
+			auto it = buses.find(core::string(name));
+			return it != buses.end() ? it->second : nullptr;
+		}
+		bool audio_device::remove_bus(const std::string_view& name)
+		{
+			auto it = buses.find(core::string(name));
+			if (it == buses.end())
+				return false;
+
+			VI_TRACE("[audio] remove %.*s bus", (int)name.size(), name.data());
+			core::memory::release(it->second);
+			buses.erase(it);
+			return true;
+		}
+		expects_audio<void> audio_device::render(float* buffer, size_t frames)
+		{
+			VI_ASSERT(buffer != nullptr, "buffer should be set");
+			VI_ASSERT(loopback, "device should be a loopback device");
+#if defined(VI_OPENAL) && defined(ALC_SOFT_loopback)
+			alcRenderSamplesSOFT((ALCdevice*)device, buffer, (ALCsizei)frames);
+#endif
+			return_error_if_dev(device);
+		}
+		expects_audio<audio_render_stats> audio_device::render_offline(core::vector<float>& output, float seconds, float step, const std::function<void(float)>& tick)
+		{
+			VI_ASSERT(loopback, "device should be a loopback device");
+			VI_ASSERT(step > 0.0f, "step should be greater than zero");
+			VI_MEASURE(core::timings::intensive);
+
+			size_t total = (size_t)(std::max(0.0f, seconds) * frequency);
+			size_t chunk = std::max<size_t>(1, (size_t)(step * frequency));
+			output.resize(total * channels);
+
+			audio_render_stats stats;
+			for (size_t offset = 0; offset < total;)
+			{
+				size_t frames = std::min(chunk, total - offset);
+				auto begin = std::chrono::high_resolution_clock::now();
+				if (tick)
+					tick((float)frames / (float)frequency);
+
+				auto middle = std::chrono::high_resolution_clock::now();
+				auto status = render(output.data() + offset * channels, frames);
+				if (!status)
+					return status.error();
+
+				auto end = std::chrono::high_resolution_clock::now();
+				stats.tick_time += std::chrono::duration<double>(middle - begin).count();
+				stats.mix_time += std::chrono::duration<double>(end - middle).count();
+				stats.frames += frames;
+				++stats.chunks;
+				offset += frames;
+			}
+
+			stats.rendered_time = (double)stats.frames / (double)frequency;
+			return stats;
+		}
 		void audio_device::display_audio_log() const
 		{
 #ifdef VI_OPENAL
@@ -961,6 +1276,18 @@ namespace vitex
 				VI_ERR("[openal] %s", alGetString(ALCode));
 #endif
 		}
+		uint32_t audio_device::get_frequency() const
+		{
+			return frequency;
+		}
+		uint32_t audio_device::get_channels() const
+		{
+			return channels;
+		}
+		bool audio_device::is_loopback() const
+		{
+			return loopback;
+		}
 		bool audio_device::is_valid() const
 		{
 			return context && device;
@@ -10,6 +10,8 @@ namespace vitex
 
 		class audio_effect;
 
+		class audio_bus;
+
 		enum class sound_distance_model
 		{
 			invalid = 0,
@@ -229,6 +231,15 @@ namespace vitex
 			bool is_looped = false;
 		};
 
+		struct audio_render_stats
+		{
+			double tick_time = 0.0;
+			double mix_time = 0.0;
+			double rendered_time = 0.0;
+			size_t frames = 0;
+			size_t chunks = 0;
+		};
+
 		class audio_exception final : public core::basic_exception
 		{
 		private:
@@ -256,6 +267,8 @@ namespace vitex
 			static expects_audio<void> set_effect1i(uint32_t effect, effect_ex value, int F1);
 			static expects_audio<void> set_effect1f(uint32_t effect, effect_ex value, float F1);
 			static expects_audio<void> set_effectvf(uint32_t effect, effect_ex value, float* FS);
+			static expects_audio<void> set_effect_slot1i(uint32_t slot, effect_ex value, int F1);
+			static expects_audio<void> set_effect_slot1f(uint32_t slot, effect_ex value, float F1);
 			static expects_audio<void> set_buffer_data(uint32_t buffer, int format, const void* data, int size, int frequency);
 			static expects_audio<void> set_source_data3f(uint32_t source, sound_ex value, float F1, float F2, float F3);
 			static expects_audio<void> get_source_data3f(uint32_t source, sound_ex value, float* F1, float* F2, float* F3);
@@ -282,6 +295,7 @@ namespace vitex
 			static expects_audio<void> set_listener_data1i(sound_ex listener, int F1);
 			static expects_audio<void> get_listener_data1i(sound_ex listener, int* F1);
 			static uint32_t get_enum_value(const char* name);
+			static uint32_t get_max_sends();
 		};
 
 		class audio_filter : public core::reference<audio_filter>
@@ -312,6 +326,7 @@ namespace vitex
 		class audio_effect : public core::reference<audio_effect>
 		{
 			friend audio_source;
+			friend audio_bus;
 
 		private:
 			int zone = -1;
@@ -344,6 +359,34 @@ namespace vitex
 			VI_COMPONENT_ROOT("base_audio_effect");
 		};
 
+		class audio_bus final : public core::reference<audio_bus>
+		{
+			friend audio_source;
+
+		private:
+			core::string name;
+			trigonometry::vector3 center;
+			audio_effect* effect;
+			float radius = 0.0f;
+			float falloff = 0.0f;
+			float gain = 1.0f;
+			float applied_gain = -1.0f;
+			bool dirty = true;
+
+		public:
+			audio_bus(const std::string_view& new_name, audio_effect* new_effect) noexcept;
+			~audio_bus() noexcept;
+			expects_audio<void> synchronize(const trigonometry::vector3& listener);
+			void set_zone(const trigonometry::vector3& new_center, float new_radius, float new_falloff);
+			void set_gain(float value);
+			void invalidate();
+			float get_zone_gain(const trigonometry::vector3& listener) const;
+			float get_gain() const;
+			audio_effect* get_effect() const;
+			const core::string& get_name() const;
+			bool is_zone() const;
+		};
+
 		class audio_clip final : public core::reference<audio_clip>
 		{
 		private:
@@ -363,8 +406,17 @@ namespace vitex
 		{
 			friend class audio_device;
 
+		private:
+			struct audio_send
+			{
+				audio_bus* bus = nullptr;
+				audio_filter* filter = nullptr;
+				float gain = 1.0f;
+			};
+
 		private:
 			core::vector<audio_effect*> effects;
+			core::vector<audio_send> sends;
 			audio_clip* clip = nullptr;
 			uint32_t instance = 0;
 
@@ -375,6 +427,9 @@ namespace vitex
 			expects_audio<void> remove_effect(size_t effect_id);
 			expects_audio<void> remove_effect_by_id(uint64_t effect_id);
 			expects_audio<void> remove_effects();
+			expects_audio<void> set_send(audio_bus* bus, float gain);
+			expects_audio<void> remove_send(audio_bus* bus);
+			expects_audio<void> remove_sends();
 			expects_audio<void> set_clip(audio_clip* clip);
 			expects_audio<void> synchronize(audio_sync* sync, const trigonometry::vector3& position);
 			expects_audio<void> reset();
@@ -383,11 +438,15 @@ namespace vitex
 			expects_audio<void> stop();
 			bool is_playing() const;
 			size_t get_effects_count() const;
+			size_t get_sends_count() const;
 			audio_clip* get_clip() const;
 			audio_effect* get_effect(uint64_t section) const;
 			uint32_t get_instance() const;
 			const core::vector<audio_effect*>& get_effects() const;
 
+		private:
+			expects_audio<void> route_sends(size_t previous_effects = 0);
+
 		public:
 			template <typename t>
 			t* get_effect()
@@ -398,13 +457,22 @@ namespace vitex
 
 		class audio_device final : public core::reference<audio_device>
 		{
+		private:
+			core::unordered_map<core::string, audio_bus*> buses;
+			uint32_t frequency = 0;
+			uint32_t channels = 0;
+			bool loopback = false;
+
 		public:
 			void* context = nullptr;
 			void* device = nullptr;
 
 		public:
 			audio_device() noexcept;
+			audio_device(uint32_t render_frequency, uint32_t render_channels) noexcept;
 			~audio_device() noexcept;
+			expects_audio<void> render(float* buffer, size_t frames);
+			expects_audio<audio_render_stats> render_offline(core::vector<float>& output, float seconds, float step, const std::function<void(float)>& tick);
 			expects_audio<void> offset(audio_source* source, float& seconds, bool get);
 			expects_audio<void> velocity(audio_source* source, trigonometry::vector3& velocity, bool get);
 			expects_audio<void> position(audio_source* source, trigonometry::vector3& position, bool get);
@@ -419,7 +487,14 @@ namespace vitex
 			expects_audio<void> distance(audio_source* source, float& value, bool get);
 			expects_audio<void> ref_distance(audio_source* source, float& value, bool get);
 			expects_audio<void> set_distance_model(sound_distance_model model);
+			expects_audio<void> synchronize_buses(const trigonometry::vector3& listener);
+			audio_bus* add_bus(const std::string_view& name, audio_effect* effect);
+			audio_bus* get_bus(const std::string_view& name) const;
+			bool remove_bus(const std::string_view& name);
 			void display_audio_log() const;
+			uint32_t get_frequency() const;
+			uint32_t get_channels() const;
+			bool is_loopback() const;
 			bool is_valid() const;
 		};
 	}
@@ -1629,11 +1629,6 @@ namespace vitex
 				expects_wrapper::unwrap_void(graphics::graphics_device::compile_builtin_shaders(array::decompose<graphics::graphics_device*>(devices), nullptr));
 			}
 
-			trigonometry::matrix4x4& animation_buffer_get_offsets(layer::animation_buffer& base, size_t index)
-			{
-				return base.offsets[index % graphics::joints_size];
-			}
-
 			void pose_buffer_set_offset(layer::pose_buffer& base, int64_t index, const layer::pose_data& data)
 			{
 				base.offsets[index] = data;
@@ -2422,6 +2417,23 @@ namespace vitex
 				return result;
 			}
 
+			array* vector3_array_distance(vector3_array* base, const trigonometry::vector3& point)
+			{
+				core::vector<float> distances(base->data.size());
+				trigonometry::geometric::distance_points(base->data.data(), distances.data(), distances.size(), point);
+
+				type_info type = virtual_machine::get()->get_type_info_by_decl(TYPENAME_ARRAY "<float>@");
+				return array::compose<float>(type.get_type_info(), distances);
+			}
+			trigonometry::vector3& vector3_array_at(vector3_array* base, size_t index)
+			{
+				return base->at(index);
+			}
+			trigonometry::matrix4x4& matrix4x4_array_at(matrix4x4_array* base, size_t index)
+			{
+				return base->at(index);
+			}
+
 			layer::gui::ielement context_get_focus_element(layer::gui::context* base, const trigonometry::vector2& value)
 			{
 				return base->get_element_at_point(value);
@@ -2431,6 +2443,111 @@ namespace vitex
 				base->emit_input(data.data(), (int)data.size());
 			}
 
+			vector3_array::vector3_array() noexcept
+			{
+			}
+			vector3_array::vector3_array(size_t size) noexcept : data(size)
+			{
+			}
+			void vector3_array::resize(size_t size)
+			{
+				data.resize(size);
+			}
+			void vector3_array::reserve(size_t size)
+			{
+				data.reserve(size);
+			}
+			void vector3_array::push(const trigonometry::vector3& value)
+			{
+				data.push_back(value);
+			}
+			void vector3_array::clear()
+			{
+				data.clear();
+			}
+			void vector3_array::transform(const trigonometry::matrix4x4& matrix)
+			{
+				trigonometry::geometric::transform_points(data.data(), data.data(), data.size(), matrix);
+			}
+			void vector3_array::lerp(vector3_array* target, float delta_time)
+			{
+				VI_ASSERT(target != nullptr, "target should be set");
+				trigonometry::geometric::lerp_points(data.data(), target->data.data(), data.data(), std::min(data.size(), target->data.size()), delta_time);
+			}
+			void vector3_array::normalize()
+			{
+				trigonometry::geometric::normalize_points(data.data(), data.data(), data.size());
+			}
+			bool vector3_array::bounds(trigonometry::vector3& min, trigonometry::vector3& max) const
+			{
+				return trigonometry::geometric::reduce_bounds(data.data(), data.size(), min, max);
+			}
+			trigonometry::vector3& vector3_array::at(size_t index)
+			{
+				if (index < data.size())
+					return data[index];
+
+				static thread_local trigonometry::vector3 invalid;
+				exception::throw_ptr(exception::pointer(EXCEPTION_OUTOFBOUNDS));
+				return invalid;
+			}
+			size_t vector3_array::size() const
+			{
+				return data.size();
+			}
+
+			matrix4x4_array::matrix4x4_array() noexcept
+			{
+			}
+			matrix4x4_array::matrix4x4_array(size_t size) noexcept : data(size)
+			{
+			}
+			void matrix4x4_array::resize(size_t size)
+			{
+				data.resize(size);
+			}
+			void matrix4x4_array::reserve(size_t size)
+			{
+				data.reserve(size);
+			}
+			void matrix4x4_array::push(const trigonometry::matrix4x4& value)
+			{
+				data.push_back(value);
+			}
+			void matrix4x4_array::clear()
+			{
+				data.clear();
+			}
+			void matrix4x4_array::mul(const trigonometry::matrix4x4& matrix)
+			{
+				trigonometry::geometric::transform_matrices(data.data(), data.data(), data.size(), matrix);
+			}
+			void matrix4x4_array::transform(vector3_array* input, vector3_array* output, size_t index) const
+			{
+				VI_ASSERT(input != nullptr && output != nullptr, "input and output should be set");
+				if (index >= data.size())
+				{
+					exception::throw_ptr(exception::pointer(EXCEPTION_OUTOFBOUNDS));
+					return;
+				}
+
+				output->data.resize(input->data.size());
+				trigonometry::geometric::transform_points(input->data.data(), output->data.data(), input->data.size(), data[index]);
+			}
+			trigonometry::matrix4x4& matrix4x4_array::at(size_t index)
+			{
+				if (index < data.size())
+					return data[index];
+
+				static thread_local trigonometry::matrix4x4 invalid;
+				exception::throw_ptr(exception::pointer(EXCEPTION_OUTOFBOUNDS));
+				return invalid;
+			}
+			size_t matrix4x4_array::size() const
+			{
+				return data.size();
+			}
+
 			model_listener::model_listener(asIScriptFunction* new_callback) noexcept : delegation(), base(new layer::gui::listener(bind(new_callback)))
 			{
 			}
@@ -3146,6 +3263,33 @@ namespace vitex
 				vm->set_function("float angle_lerp(float, float, float)", &trigonometry::geometric::angluar_lerp);
 				vm->end_namespace();
 
+				auto vvector3_array = vm->set_class<vector3_array>("vector3_array", false);
+				vvector3_array->set_constructor<vector3_array>("vector3_array@ f()");
+				vvector3_array->set_constructor<vector3_array, size_t>("vector3_array@ f(usize)");
+				vvector3_array->set_method("void resize(usize)", &vector3_array::resize);
+				vvector3_array->set_method("void reserve(usize)", &vector3_array::reserve);
+				vvector3_array->set_method("void push(const vector3 &in)", &vector3_array::push);
+				vvector3_array->set_method("void clear()", &vector3_array::clear);
+				vvector3_array->set_method("void transform(const matrix4x4 &in)", &vector3_array::transform);
+				vvector3_array->set_method("void lerp(vector3_array@+, float)", &vector3_array::lerp);
+				vvector3_array->set_method("void normalize()", &vector3_array::normalize);
+				vvector3_array->set_method("bool bounds(vector3 &out, vector3 &out) const", &vector3_array::bounds);
+				vvector3_array->set_method("usize size() const", &vector3_array::size);
+				vvector3_array->set_method_extern("array<float>@ distance(const vector3 &in) const", &vector3_array_distance);
+				vvector3_array->set_operator_extern(operators::index_t, (uint32_t)position::left, "vector3&", "usize", &vector3_array_at);
+
+				auto vmatrix4x4_array = vm->set_class<matrix4x4_array>("matrix4x4_array", false);
+				vmatrix4x4_array->set_constructor<matrix4x4_array>("matrix4x4_array@ f()");
+				vmatrix4x4_array->set_constructor<matrix4x4_array, size_t>("matrix4x4_array@ f(usize)");
+				vmatrix4x4_array->set_method("void resize(usize)", &matrix4x4_array::resize);
+				vmatrix4x4_array->set_method("void reserve(usize)", &matrix4x4_array::reserve);
+				vmatrix4x4_array->set_method("void push(const matrix4x4 &in)", &matrix4x4_array::push);
+				vmatrix4x4_array->set_method("void clear()", &matrix4x4_array::clear);
+				vmatrix4x4_array->set_method("void mul(const matrix4x4 &in)", &matrix4x4_array::mul);
+				vmatrix4x4_array->set_method("void transform(vector3_array@+, vector3_array@+, usize) const", &matrix4x4_array::transform);
+				vmatrix4x4_array->set_method("usize size() const", &matrix4x4_array::size);
+				vmatrix4x4_array->set_operator_extern(operators::index_t, (uint32_t)position::left, "matrix4x4&", "usize", &matrix4x4_array_at);
+
 				return true;
 #else
 				VI_ASSERT(false, "<trigonometry> is not loaded");
@@ -5763,11 +5907,10 @@ namespace vitex
 				vpose_data->set_constructor<layer::pose_data>("void f()");
 
 				auto vanimation_buffer = vm->set_pod<layer::animation_buffer>("animation_buffer");
-				vanimation_buffer->set_property<layer::animation_buffer>("vector3 padding", &layer::animation_buffer::padding);
+				vanimation_buffer->set_property<layer::animation_buffer>("float offset", &layer::animation_buffer::offset);
 				vanimation_buffer->set_property<layer::animation_buffer>("float animated", &layer::animation_buffer::animated);
+				vanimation_buffer->set_property<layer::animation_buffer>("vector2 padding", &layer::animation_buffer::padding);
 				vanimation_buffer->set_constructor<layer::animation_buffer>("void f()");
-				vanimation_buffer->set_operator_extern(operators::index_t, (uint32_t)position::left, "matrix4x4&", "usize", &animation_buffer_get_offsets);
-				vanimation_buffer->set_operator_extern(operators::index_t, (uint32_t)position::constant, "const matrix4x4&", "usize", &animation_buffer_get_offsets);
 
 				auto vrender_buffer_instance = vm->set_pod<layer::render_buffer::instance>("render_buffer_instance");
 				vrender_buffer_instance->set_property<layer::render_buffer::instance>("matrix4x4 transform", &layer::render_buffer::instance::transform);
@@ -6549,7 +6692,7 @@ namespace vitex
 				vskin_animator->set_method("void stop()", &layer::components::skin_animator::stop);
 				vskin_animator->set_method<layer::components::skin_animator, bool, int64_t>("bool is_exists(int64) const", &layer::components::skin_animator::is_exists);
 				vskin_animator->set_method<layer::components::skin_animator, bool, int64_t, int64_t>("bool is_exists(int64, int64) const", &layer::components::skin_animator::is_exists);
-				vskin_animator->set_method("skin_animator_key& get_frame(int64, int64) const", &layer::components::skin_animator::get_frame);
+				vskin_animator->set_method("skin_animator_key get_frame(int64, int64) const", &layer::components::skin_animator::get_frame);
 				vskin_animator->set_method("skin_component@+ get_skin() const", &layer::components::skin_animator::get_skin);
 				vskin_animator->set_method("skin_animation@+ get_animation() const", &layer::components::skin_animator::get_animation);
 				vskin_animator->set_method("string get_path() const", &layer::components::skin_animator::get_path);
@@ -10,6 +10,46 @@ namespace vitex
 		namespace bindings
 		{
 #ifdef VI_BINDINGS
+			class vector3_array : public core::reference<vector3_array>
+			{
+			public:
+				core::vector<trigonometry::vector3> data;
+
+			public:
+				vector3_array() noexcept;
+				vector3_array(size_t size) noexcept;
+				~vector3_array() noexcept = default;
+				void resize(size_t size);
+				void reserve(size_t size);
+				void push(const trigonometry::vector3& value);
+				void clear();
+				void transform(const trigonometry::matrix4x4& matrix);
+				void lerp(vector3_array* target, float delta_time);
+				void normalize();
+				bool bounds(trigonometry::vector3& min, trigonometry::vector3& max) const;
+				trigonometry::vector3& at(size_t index);
+				size_t size() const;
+			};
+
+			class matrix4x4_array : public core::reference<matrix4x4_array>
+			{
+			public:
+				core::vector<trigonometry::matrix4x4> data;
+
+			public:
+				matrix4x4_array() noexcept;
+				matrix4x4_array(size_t size) noexcept;
+				~matrix4x4_array() noexcept = default;
+				void resize(size_t size);
+				void reserve(size_t size);
+				void push(const trigonometry::matrix4x4& value);
+				void clear();
+				void mul(const trigonometry::matrix4x4& matrix);
+				void transform(vector3_array* input, vector3_array* output, size_t index) const;
+				trigonometry::matrix4x4& at(size_t index);
+				size_t size() const;
+			};
+
 			class model_listener : public core::reference<model_listener>
 			{
 			private:
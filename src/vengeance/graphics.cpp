@@ -1026,6 +1026,23 @@ namespace vitex
 			};
 			input_layouts["vx_skin"] = *create_input_layout(layout);
 
+			layout.attributes =
+			{
+				{ "POSITION", 0, attribute_type::floatf, 3, 0 },
+				{ "TEXCOORD", 0, attribute_type::floatf, 2, 3 * sizeof(float) },
+				{ "NORMAL", 0, attribute_type::floatf, 3, 5 * sizeof(float) },
+				{ "TANGENT", 0, attribute_type::floatf, 3, 8 * sizeof(float) },
+				{ "BINORMAL", 0, attribute_type::floatf, 3, 11 * sizeof(float) },
+				{ "JOINTBIAS", 0, attribute_type::floatf, 4, 14 * sizeof(float) },
+				{ "JOINTBIAS", 1, attribute_type::floatf, 4, 18 * sizeof(float) },
+				{ "OB_TRANSFORM", 0, attribute_type::matrix, 16, 0, 1, false },
+				{ "OB_WORLD", 0, attribute_type::matrix, 16, sizeof(trigonometry::matrix4x4), 1, false },
+				{ "OB_TEXCOORD", 0, attribute_type::floatf, 2, sizeof(trigonometry::matrix4x4) * 2, 1, false },
+				{ "OB_MATERIAL", 0, attribute_type::floatf, 4, sizeof(trigonometry::matrix4x4) * 2 + 2 * sizeof(float), 1, false },
+				{ "OB_PALETTE", 0, attribute_type::floatf, 2, sizeof(trigonometry::matrix4x4) * 2 + 6 * sizeof(float), 1, false }
+			};
+			input_layouts["vxi_skin"] = *create_input_layout(layout);
+
 			layout.attributes =
 			{
 				{ "POSITION", 0, attribute_type::floatf, 2, 0 },
@@ -1734,6 +1734,8 @@ namespace vitex
 			virtual void draw_indexed_instanced(uint32_t index_count_per_instance, uint32_t instance_count, uint32_t index_location, uint32_t vertex_location, uint32_t instance_location) = 0;
 			virtual void draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count) = 0;
 			virtual void draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count) = 0;
+			virtual void draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location) = 0;
+			virtual void draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location) = 0;
 			virtual void draw(uint32_t count, uint32_t location) = 0;
 			virtual void draw_instanced(uint32_t vertex_count_per_instance, uint32_t instance_count, uint32_t vertex_location, uint32_t instance_location) = 0;
 			virtual void dispatch(uint32_t group_x, uint32_t group_y, uint32_t group_z) = 0;
@@ -1769,6 +1771,7 @@ namespace vitex
 			virtual expects_graphics<void> unmap(element_buffer* resource, mapped_subresource* map) = 0;
 			virtual expects_graphics<void> update_constant_buffer(element_buffer* resource, void* data, size_t size) = 0;
 			virtual expects_graphics<void> update_buffer(element_buffer* resource, void* data, size_t size) = 0;
+			virtual expects_graphics<void> update_buffer(element_buffer* resource, void* data, size_t offset, size_t size) = 0;
 			virtual expects_graphics<void> update_buffer(shader* resource, const void* data) = 0;
 			virtual expects_graphics<void> update_buffer(mesh_buffer* resource, trigonometry::vertex* data) = 0;
 			virtual expects_graphics<void> update_buffer(skin_mesh_buffer* resource, trigonometry::skin_vertex* data) = 0;
@@ -1480,6 +1480,14 @@ namespace vitex
 				immediate_context->DrawIndexedInstanced(index_count_per_instance, instance_count, index_location, vertex_location, instance_location);
 			}
 			void d3d11_device::draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count)
+			{
+				draw_indexed_instanced(instances, resource, instance_count, 0);
+			}
+			void d3d11_device::draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count)
+			{
+				draw_indexed_instanced(instances, resource, instance_count, 0);
+			}
+			void d3d11_device::draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location)
 			{
 				VI_ASSERT(instances != nullptr, "instances should be set");
 				VI_ASSERT(resource != nullptr, "resource should be set");
@@ -1503,9 +1511,9 @@ namespace vitex
 
 				stride = (uint32_t)instance_buffer->stride;
 				immediate_context->IASetVertexBuffers(1, 1, &instance_buffer->element, &stride, &offset);
-				immediate_context->DrawIndexedInstanced((uint32_t)index_buffer->get_elements(), instance_count, 0, 0, 0);
+				immediate_context->DrawIndexedInstanced((uint32_t)index_buffer->get_elements(), instance_count, 0, 0, instance_location);
 			}
-			void d3d11_device::draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count)
+			void d3d11_device::draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location)
 			{
 				VI_ASSERT(instances != nullptr, "instances should be set");
 				VI_ASSERT(resource != nullptr, "resource should be set");
@@ -1529,7 +1537,7 @@ namespace vitex
 
 				stride = (uint32_t)instance_buffer->stride;
 				immediate_context->IASetVertexBuffers(1, 1, &instance_buffer->element, &stride, &offset);
-				immediate_context->DrawIndexedInstanced((uint32_t)index_buffer->get_elements(), instance_count, 0, 0, 0);
+				immediate_context->DrawIndexedInstanced((uint32_t)index_buffer->get_elements(), instance_count, 0, 0, instance_location);
 			}
 			void d3d11_device::draw(uint32_t count, uint32_t location)
 			{
@@ -1959,6 +1967,16 @@ namespace vitex
 				immediate_context->Unmap(iresource->element, 0);
 				return core::expectation::met;
 			}
+			expects_graphics<void> d3d11_device::update_buffer(element_buffer* resource, void* data, size_t offset, size_t size)
+			{
+				VI_ASSERT(resource != nullptr, "resource should be set");
+				VI_ASSERT(data != nullptr, "data should be set");
+
+				d3d11_element_buffer* iresource = (d3d11_element_buffer*)resource;
+				D3D11_BOX box = { (UINT)offset, 0, 0, (UINT)(offset + size), 1, 1 };
+				immediate_context->UpdateSubresource(iresource->element, 0, &box, data, 0, 0);
+				return core::expectation::met;
+			}
 			expects_graphics<void> d3d11_device::update_buffer(shader* resource, const void* data)
 			{
 				VI_ASSERT(resource != nullptr, "resource should be set");
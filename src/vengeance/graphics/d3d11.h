@@ -446,6 +446,8 @@ namespace vitex
 				void draw_indexed_instanced(uint32_t index_count_per_instance, uint32_t instance_count, uint32_t index_location, uint32_t vertex_location, uint32_t instance_location) override;
 				void draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count) override;
 				void draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count) override;
+				void draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location) override;
+				void draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location) override;
 				void draw(uint32_t count, uint32_t location) override;
 				void draw_instanced(uint32_t vertex_count_per_instance, uint32_t instance_count, uint32_t vertex_location, uint32_t instance_location) override;
 				void dispatch(uint32_t group_x, uint32_t group_y, uint32_t group_z) override;
@@ -481,6 +483,7 @@ namespace vitex
 				expects_graphics<void> unmap(element_buffer* resource, mapped_subresource* map) override;
 				expects_graphics<void> update_constant_buffer(element_buffer* resource, void* data, size_t size) override;
 				expects_graphics<void> update_buffer(element_buffer* resource, void* data, size_t size) override;
+				expects_graphics<void> update_buffer(element_buffer* resource, void* data, size_t offset, size_t size) override;
 				expects_graphics<void> update_buffer(shader* resource, const void* data) override;
 				expects_graphics<void> update_buffer(mesh_buffer* resource, trigonometry::vertex* data) override;
 				expects_graphics<void> update_buffer(skin_mesh_buffer* resource, trigonometry::skin_vertex* data) override;
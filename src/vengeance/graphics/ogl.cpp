@@ -22,6 +22,18 @@ namespace
 	{
 		seed ^= std::hash<t>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 	}
+	static size_t ogl_get_index_size(GLenum format)
+	{
+		switch (format)
+		{
+			case GL_UNSIGNED_BYTE:
+				return sizeof(uint8_t);
+			case GL_UNSIGNED_SHORT:
+				return sizeof(uint16_t);
+			default:
+				return sizeof(uint32_t);
+		}
+	}
 	static int64_t d3d_get_coord_y(int64_t y, int64_t height, int64_t window_height)
 	{
 		return window_height - height - y;
@@ -222,10 +234,10 @@ namespace vitex
 						for (size_t k = 0; k < 4; k++)
 						{
 							size_t offset = layout_size(), substride = stride + sizeof(float) * size * k;
-							layout.emplace_back([offset, format, normalize, substride, size, per_vertex](size_t width)
+							layout.emplace_back([offset, format, normalize, substride, size, per_vertex](size_t width, size_t location)
 							{
 								glEnableVertexAttribArray((GLuint)offset);
-								glVertexAttribPointer((GLuint)offset, size, format, normalize, (GLsizei)width, OGL_VOFFSET(substride));
+								glVertexAttribPointer((GLuint)offset, size, format, normalize, (GLsizei)width, OGL_VOFFSET(substride + (per_vertex ? 0 : location * width)));
 								glVertexAttribDivisor((GLuint)offset, per_vertex ? 0 : 1);
 							});
 						}
@@ -233,10 +245,10 @@ namespace vitex
 					else
 					{
 						size_t offset = layout_size();
-						layout.emplace_back([offset, format, normalize, stride, size, per_vertex](size_t width)
+						layout.emplace_back([offset, format, normalize, stride, size, per_vertex](size_t width, size_t location)
 						{
 							glEnableVertexAttribArray((GLuint)offset);
-							glVertexAttribPointer((GLuint)offset, size, format, normalize, (GLsizei)width, OGL_VOFFSET(stride));
+							glVertexAttribPointer((GLuint)offset, size, format, normalize, (GLsizei)width, OGL_VOFFSET(stride + (per_vertex ? 0 : location * width)));
 							glVertexAttribDivisor((GLuint)offset, per_vertex ? 0 : 1);
 						});
 					}
@@ -1128,7 +1140,7 @@ namespace vitex
 					iresource->bindings[buffer] = regs.layout;
 					glBindBuffer(GL_ARRAY_BUFFER, iresource->resource);
 					for (auto& attribute : regs.layout->vertex_layout[i])
-						attribute(iresource->stride);
+						attribute(iresource->stride, 0);
 				}
 			}
 			void ogl_device::set_texture_2d(texture_2d* resource, uint32_t slot, uint32_t type)
@@ -1518,7 +1530,7 @@ namespace vitex
 			}
 			void ogl_device::draw_indexed(uint32_t count, uint32_t index_location, uint32_t base_location)
 			{
-				glDrawElements(regs.draw_topology, count, regs.index_format, OGL_OFFSET((size_t)index_location));
+				glDrawElementsBaseVertex(regs.draw_topology, (GLsizei)count, regs.index_format, OGL_OFFSET((size_t)index_location * ogl_get_index_size(regs.index_format)), (GLint)base_location);
 			}
 			void ogl_device::draw_indexed(mesh_buffer* resource)
 			{
@@ -1542,9 +1554,26 @@ namespace vitex
 			}
 			void ogl_device::draw_indexed_instanced(uint32_t index_count_per_instance, uint32_t instance_count, uint32_t index_location, uint32_t vertex_location, uint32_t instance_location)
 			{
-				glDrawElementsInstanced(regs.draw_topology, index_count_per_instance, GL_UNSIGNED_INT, nullptr, instance_count);
+				GLvoid* offset = OGL_OFFSET((size_t)index_location * ogl_get_index_size(regs.index_format));
+				if (GLEW_VERSION_4_2 || GLEW_ARB_base_instance)
+					return (void)glDrawElementsInstancedBaseVertexBaseInstance(regs.draw_topology, (GLsizei)index_count_per_instance, regs.index_format, offset, (GLsizei)instance_count, (GLint)vertex_location, (GLuint)instance_location);
+
+				if (instance_location > 0)
+					set_instance_location(instance_location);
+
+				glDrawElementsInstancedBaseVertex(regs.draw_topology, (GLsizei)index_count_per_instance, regs.index_format, offset, (GLsizei)instance_count, (GLint)vertex_location);
+				if (instance_location > 0)
+					set_instance_location(0);
 			}
 			void ogl_device::draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count)
+			{
+				draw_indexed_instanced(instances, resource, instance_count, 0);
+			}
+			void ogl_device::draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count)
+			{
+				draw_indexed_instanced(instances, resource, instance_count, 0);
+			}
+			void ogl_device::draw_indexed_instanced(element_buffer* instances, mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location)
 			{
 				VI_ASSERT(instances != nullptr, "instances should be set");
 				VI_ASSERT(resource != nullptr, "resource should be set");
@@ -1554,9 +1583,13 @@ namespace vitex
 				set_vertex_buffers(vertex_buffers, 2, true);
 				set_index_buffer(index_buffer, format::r32_uint);
 
+				if (GLEW_VERSION_4_2 || GLEW_ARB_base_instance)
+					return (void)glDrawElementsInstancedBaseInstance(regs.draw_topology, (GLsizei)index_buffer->get_elements(), GL_UNSIGNED_INT, nullptr, (GLsizei)instance_count, (GLuint)instance_location);
+
+				set_instance_location(instance_location);
 				glDrawElementsInstanced(regs.draw_topology, (GLsizei)index_buffer->get_elements(), GL_UNSIGNED_INT, nullptr, (GLsizei)instance_count);
 			}
-			void ogl_device::draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count)
+			void ogl_device::draw_indexed_instanced(element_buffer* instances, skin_mesh_buffer* resource, uint32_t instance_count, uint32_t instance_location)
 			{
 				VI_ASSERT(instances != nullptr, "instances should be set");
 				VI_ASSERT(resource != nullptr, "resource should be set");
@@ -1566,6 +1599,10 @@ namespace vitex
 				set_vertex_buffers(vertex_buffers, 2, true);
 				set_index_buffer(index_buffer, format::r32_uint);
 
+				if (GLEW_VERSION_4_2 || GLEW_ARB_base_instance)
+					return (void)glDrawElementsInstancedBaseInstance(regs.draw_topology, (GLsizei)index_buffer->get_elements(), GL_UNSIGNED_INT, nullptr, (GLsizei)instance_count, (GLuint)instance_location);
+
+				set_instance_location(instance_location);
 				glDrawElementsInstanced(regs.draw_topology, (GLsizei)index_buffer->get_elements(), GL_UNSIGNED_INT, nullptr, (GLsizei)instance_count);
 			}
 			void ogl_device::draw(uint32_t count, uint32_t location)
@@ -1840,7 +1877,10 @@ namespace vitex
 
 				GLint size;
 				glGetBufferParameteriv(iresource->flags, GL_BUFFER_SIZE, &size);
-				map->pointer = glMapBuffer(iresource->flags, ogl_device::get_resource_map(mode));
+				if (mode == resource_map::write_discard || mode == resource_map::write_no_overwrite)
+					map->pointer = glMapBufferRange(iresource->flags, 0, (GLsizeiptr)size, GL_MAP_WRITE_BIT | (mode == resource_map::write_discard ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_UNSYNCHRONIZED_BIT));
+				else
+					map->pointer = glMapBuffer(iresource->flags, ogl_device::get_resource_map(mode));
 				map->row_pitch = get_row_pitch(1, (uint32_t)size);
 				map->depth_pitch = get_depth_pitch(map->row_pitch, 1);
 				if (!map->pointer)
@@ -2023,6 +2063,15 @@ namespace vitex
 				glBindBuffer(iresource->flags, GL_NONE);
 				return core::expectation::met;
 			}
+			expects_graphics<void> ogl_device::update_buffer(element_buffer* resource, void* data, size_t offset, size_t size)
+			{
+				VI_ASSERT(resource != nullptr, "resource should be set");
+				ogl_element_buffer* iresource = (ogl_element_buffer*)resource;
+				glBindBuffer(iresource->flags, iresource->resource);
+				glBufferSubData(iresource->flags, (GLintptr)offset, (GLsizeiptr)size, data);
+				glBindBuffer(iresource->flags, GL_NONE);
+				return core::expectation::met;
+			}
 			expects_graphics<void> ogl_device::update_buffer(shader* resource, const void* data)
 			{
 				VI_ASSERT(resource != nullptr, "resource should be set");
@@ -4026,6 +4075,22 @@ namespace vitex
 				set_vertex_buffers(nullptr, 0);
 				return core::expectation::met;
 			}
+			void ogl_device::set_instance_location(uint32_t location)
+			{
+				if (!regs.layout)
+					return;
+
+				for (auto& slot : regs.layout->vertex_layout)
+				{
+					ogl_element_buffer* iresource = slot.first < units_size ? regs.vertex_buffers[slot.first] : nullptr;
+					if (!iresource)
+						continue;
+
+					glBindBuffer(GL_ARRAY_BUFFER, iresource->resource);
+					for (auto& attribute : slot.second)
+						attribute(iresource->stride, location);
+				}
+			}
 			uint64_t ogl_device::get_program_hash()
 			{
 				static uint64_t seed = compute::crypto::random();
@@ -1,6 +1,17 @@
 cbuffer AnimationBuffer : register(b0)
 {
-	matrix ab_Offsets[96];
-	float3 ab_Padding;
+	float ab_Offset;
 	float ab_Animated;
-};
\ No newline at end of file
+	float2 ab_Padding;
+};
+
+StructuredBuffer<matrix> JointPalette : register(t8);
+
+matrix GetJointOffset(float4 Index, float4 Bias, uint Offset)
+{
+	return
+		mul(JointPalette[Offset + (uint)Index.x], Bias.x) +
+		mul(JointPalette[Offset + (uint)Index.y], Bias.y) +
+		mul(JointPalette[Offset + (uint)Index.z], Bias.z) +
+		mul(JointPalette[Offset + (uint)Index.w], Bias.w);
+}
\ No newline at end of file
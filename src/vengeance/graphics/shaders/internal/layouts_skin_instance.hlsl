@@ -0,0 +1,49 @@
+struct VInput
+{
+	float3 Position : POSITION;
+	float2 Texcoord : TEXCOORD0;
+	float3 Normal : NORMAL0;
+	float3 Tangent : TANGENT0;
+	float3 Bitangent : BINORMAL0;
+	float4 Index : JOINTBIAS0;
+	float4 Bias : JOINTBIAS1;
+	matrix OB_Transform : OB_TRANSFORM;
+	matrix OB_World : OB_WORLD;
+	float2 OB_Texcoord : OB_TEXCOORD;
+	float4 OB_Material : OB_MATERIAL;
+	float2 OB_Palette : OB_PALETTE;
+};
+
+struct VOutput
+{
+	float4 Position : SV_POSITION;
+	float2 Texcoord : TEXCOORD0;
+	float3 Normal : NORMAL0;
+	float3 Tangent : TANGENT0;
+	float3 Bitangent : BINORMAL0;
+	float4 UV : TEXCOORD1;
+	float3 Direction : TEXCOORD2;
+	float OB_Diffuse : TEXCOORD3;
+	float OB_Normal : TEXCOORD4;
+	float OB_Height : TEXCOORD5;
+	uint OB_MaterialId : TEXCOORD6;
+};
+
+struct VOutputCube
+{
+	float4 Position : SV_POSITION;
+	float2 Texcoord : TEXCOORD0;
+	float4 UV : TEXCOORD1;
+	float OB_Diffuse : TEXCOORD2;
+	uint OB_MaterialId : TEXCOORD3;
+	uint RenderTarget : SV_RenderTargetArrayIndex;
+};
+
+struct VOutputLinear
+{
+	float4 Position : SV_POSITION;
+	float2 Texcoord : TEXCOORD0;
+	float4 UV : TEXCOORD1;
+	float OB_Diffuse : TEXCOORD2;
+	uint OB_MaterialId : TEXCOORD3;
+};
\ No newline at end of file
@@ -1,4 +1,4 @@
-#include "internal/layouts_skin.hlsl"
+#include "internal/layouts_skin_instance.hlsl"
 #include "internal/channels_depth.hlsl"
 #include "internal/buffers_object.hlsl"
 #include "internal/buffers_animation.hlsl"
@@ -6,27 +6,21 @@
 VOutputLinear vs_main(VInput V)
 {
 	VOutputLinear Result = (VOutputLinear)0;
-	Result.Texcoord = V.Texcoord * ob_Texcoord.xy;
+	Result.Texcoord = V.Texcoord * V.OB_Texcoord.xy;
+	Result.OB_Diffuse = V.OB_Material.x;
+	Result.OB_MaterialId = V.OB_Material.w;
 
-	[branch] if (ab_Animated > 0)
-	{
-		matrix Offset =
-			mul(ab_Offsets[(int)V.Index.x], V.Bias.x) +
-			mul(ab_Offsets[(int)V.Index.y], V.Bias.y) +
-			mul(ab_Offsets[(int)V.Index.z], V.Bias.z) +
-			mul(ab_Offsets[(int)V.Index.w], V.Bias.w);
-
-		Result.Position = Result.UV = mul(mul(float4(V.Position, 1.0), Offset), ob_Transform);
-	}
+	[branch] if (V.OB_Palette.y > 0)
+		Result.Position = Result.UV = mul(mul(float4(V.Position, 1.0), GetJointOffset(V.Index, V.Bias, (uint)V.OB_Palette.x)), V.OB_Transform);
 	else
-		Result.Position = Result.UV = mul(float4(V.Position, 1.0), ob_Transform);
+		Result.Position = Result.UV = mul(float4(V.Position, 1.0), V.OB_Transform);
 
 	return Result;
 }
 
 float ps_main(VOutputLinear V) : SV_DEPTH
 {
-	float Threshold = (ob_Diffuse ? 1.0 - GetDiffuse(V.Texcoord).w : 1.0) * Materials[ob_MaterialId].Transparency;
+	float Threshold = (V.OB_Diffuse ? 1.0 - GetDiffuse(V.Texcoord).w : 1.0) * Materials[V.OB_MaterialId].Transparency;
 	[branch] if (Threshold > 0.5)
 		discard;
 	
@@ -1,4 +1,4 @@
-#include "internal/layouts_skin.hlsl"
+#include "internal/layouts_skin_instance.hlsl"
 #include "internal/channels_gbuffer.hlsl"
 #include "internal/buffers_object.hlsl"
 #include "internal/buffers_viewer.hlsl"
@@ -7,47 +7,46 @@
 VOutput vs_main(VInput V)
 {
 	VOutput Result = (VOutput)0;
-	Result.Texcoord = V.Texcoord * ob_Texcoord.xy;
+	Result.Texcoord = V.Texcoord * V.OB_Texcoord.xy;
+	Result.OB_Diffuse = V.OB_Material.x;
+	Result.OB_Normal = V.OB_Material.y;
+	Result.OB_Height = V.OB_Material.z;
+	Result.OB_MaterialId = V.OB_Material.w;
 
 	float4 Position = float4(V.Position, 1.0);
-	[branch] if (ab_Animated > 0)
+	[branch] if (V.OB_Palette.y > 0)
 	{
-		matrix Offset =
-			mul(ab_Offsets[(int)V.Index.x], V.Bias.x) +
-			mul(ab_Offsets[(int)V.Index.y], V.Bias.y) +
-			mul(ab_Offsets[(int)V.Index.z], V.Bias.z) +
-			mul(ab_Offsets[(int)V.Index.w], V.Bias.w);
-
+		matrix Offset = GetJointOffset(V.Index, V.Bias, (uint)V.OB_Palette.x);
 		Position = mul(float4(V.Position, 1.0), Offset);
-		Result.Position = Result.UV = mul(Position, ob_Transform);
-		Result.Normal = normalize(mul(mul(float4(V.Normal, 0), Offset).xyz, (float3x3)ob_World));
-		Result.Tangent = normalize(mul(mul(float4(V.Tangent, 0), Offset).xyz, (float3x3)ob_World));
-		Result.Bitangent = normalize(mul(mul(float4(V.Bitangent, 0), Offset).xyz, (float3x3)ob_World));   
+		Result.Position = Result.UV = mul(Position, V.OB_Transform);
+		Result.Normal = normalize(mul(mul(float4(V.Normal, 0), Offset).xyz, (float3x3)V.OB_World));
+		Result.Tangent = normalize(mul(mul(float4(V.Tangent, 0), Offset).xyz, (float3x3)V.OB_World));
+		Result.Bitangent = normalize(mul(mul(float4(V.Bitangent, 0), Offset).xyz, (float3x3)V.OB_World));
 	}
 	else
 	{
-		Result.Position = Result.UV = mul(Position, ob_Transform);
-		Result.Normal = normalize(mul(V.Normal, (float3x3)ob_World));
-		Result.Tangent = normalize(mul(V.Tangent, (float3x3)ob_World));
-		Result.Bitangent = normalize(mul(V.Bitangent, (float3x3)ob_World));
+		Result.Position = Result.UV = mul(Position, V.OB_Transform);
+		Result.Normal = normalize(mul(V.Normal, (float3x3)V.OB_World));
+		Result.Tangent = normalize(mul(V.Tangent, (float3x3)V.OB_World));
+		Result.Bitangent = normalize(mul(V.Bitangent, (float3x3)V.OB_World));
 	}
 
-	[branch] if (ob_Height > 0)
-		Result.Direction = GetDirection(Result.Tangent, Result.Bitangent, Result.Normal, mul(Position, ob_World), ob_Texcoord.xy);
+	[branch] if (Result.OB_Height > 0)
+		Result.Direction = GetDirection(Result.Tangent, Result.Bitangent, Result.Normal, mul(Position, V.OB_World), V.OB_Texcoord.xy);
 
 	return Result;
 }
 
 GBuffer ps_main(VOutput V)
 {
-	Material Mat = Materials[ob_MaterialId];
+	Material Mat = Materials[V.OB_MaterialId];
 	float2 Coord = V.Texcoord;
 
-	[branch] if (ob_Height > 0)
+	[branch] if (V.OB_Height > 0)
 		Coord = GetParallax(Coord, V.Direction, Mat.Height, Mat.Bias);
 	
 	float4 Color = float4(Mat.Diffuse, 1.0);
-	[branch] if (ob_Diffuse > 0)
+	[branch] if (V.OB_Diffuse > 0)
 	{
 		Color *= GetDiffuse(Coord);
 		if (Color.w < 0.001)
@@ -55,8 +54,8 @@ GBuffer ps_main(VOutput V)
 	}
 
 	float3 Normal = V.Normal;
-	[branch] if (ob_Normal > 0)
+	[branch] if (V.OB_Normal > 0)
 		Normal = GetNormal(Coord, V.Normal, V.Tangent, V.Bitangent);
 
-	return Compose(Coord, Color, Normal, V.UV.z / V.UV.w, ob_MaterialId);
+	return Compose(Coord, Color, Normal, V.UV.z / V.UV.w, V.OB_MaterialId);
 };
\ No newline at end of file
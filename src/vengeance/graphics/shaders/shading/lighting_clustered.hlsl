@@ -0,0 +1,130 @@
+#include "internal/layouts_shape.hlsl"
+#include "internal/channels_effect.hlsl"
+#include "internal/utils_lighting.hlsl"
+#include "internal/utils_material.hlsl"
+#include "internal/utils_position.hlsl"
+#pragma warning(disable: 4000)
+
+struct PointLight
+{
+	matrix Transform;
+	float4 Attenuation;
+	float3 Position;
+	float Range;
+	float3 Lighting;
+	float Distance;
+	float Umbra;
+	float Softness;
+	float Bias;
+	float Iterations;
+};
+
+struct SpotLight
+{
+	matrix Transform;
+	matrix ViewProjection;
+	float4 Attenuation;
+	float3 Direction;
+	float Cutoff;
+	float3 Position;
+	float Range;
+	float3 Lighting;
+	float Softness;
+	float Bias;
+	float Iterations;
+	float Umbra;
+	float Padding;
+};
+
+struct Cluster
+{
+	uint Offset;
+	uint Points;
+	uint Spots;
+	uint Padding;
+};
+
+cbuffer ClusterBuffer : register(b3)
+{
+	float3 GridSize;
+	float SliceScale;
+	float SliceBias;
+	float Near;
+	float Far;
+	float Padding;
+};
+
+StructuredBuffer<PointLight> PointLights : register(t5);
+StructuredBuffer<SpotLight> SpotLights : register(t6);
+StructuredBuffer<Cluster> Clusters : register(t7);
+StructuredBuffer<uint> ClusterIndices : register(t8);
+
+uint GetClusterIndex(float2 Texcoord, float3 Position)
+{
+#ifdef TARGET_D3D
+	float2 Screen = float2(Texcoord.x, 1.0 - Texcoord.y);
+#else
+	float2 Screen = Texcoord;
+#endif
+	float Depth = clamp(dot(Position - vb_Position, vb_Direction), Near, Far);
+	uint3 Cell = uint3(clamp(Screen * GridSize.xy, 0.0, GridSize.xy - 1.0), clamp(log(Depth) * SliceScale - SliceBias, 0.0, GridSize.z - 1.0));
+	return (Cell.z * (uint)GridSize.y + Cell.y) * (uint)GridSize.x + Cell.x;
+}
+
+VOutput vs_main(VInput V)
+{
+	VOutput Result = (VOutput)0;
+	Result.Position = float4(V.Position, 1.0);
+	Result.Texcoord = Result.Position;
+
+	return Result;
+}
+
+float4 ps_main(VOutput V) : SV_TARGET0
+{
+	float2 Texcoord = GetTexcoord(V.Texcoord);
+	Fragment Frag = GetFragment(Texcoord);
+	[branch] if (Frag.Depth >= 1.0)
+		return float4(0, 0, 0, 0);
+
+	Cluster Next = Clusters[GetClusterIndex(Texcoord, Frag.Position)];
+	[branch] if (Next.Points + Next.Spots == 0)
+		return float4(0, 0, 0, 0);
+
+	Material Mat = Materials[Frag.Material];
+	float G = GetRoughness(Frag, Mat);
+	float3 M = GetMetallic(Frag, Mat);
+	float3 D = normalize(vb_Position - Frag.Position);
+	float4 Result = float4(0, 0, 0, 0);
+
+	[loop] for (uint i = 0; i < Next.Points; i++)
+	{
+		PointLight Light = PointLights[ClusterIndices[Next.Offset + i]];
+		float3 K = Light.Position - Frag.Position;
+		float A = GetRangeAttenuation(K, Light.Attenuation.x, Light.Attenuation.y, Light.Range);
+		[branch] if (A <= 0.0)
+			continue;
+
+		float3 L = normalize(K);
+		float3 R = GetCookTorranceBRDF(Frag.Normal, D, L, Frag.Diffuse, M, G);
+		float3 S = GetSubsurface(Frag.Normal, L, Mat.Subsurface, Mat.Scattering);
+		Result += float4(Light.Lighting * (R + S) * A, A);
+	}
+
+	uint Offset = Next.Offset + Next.Points;
+	[loop] for (uint j = 0; j < Next.Spots; j++)
+	{
+		SpotLight Light = SpotLights[ClusterIndices[Offset + j]];
+		float3 K = Light.Position - Frag.Position;
+		float3 L = normalize(K);
+		float A = GetConeAttenuation(K, L, Light.Attenuation.x, Light.Attenuation.y, Light.Range, Light.Direction, Light.Cutoff);
+		[branch] if (A <= 0.0)
+			continue;
+
+		float3 R = GetCookTorranceBRDF(Frag.Normal, D, L, Frag.Diffuse, M, G);
+		float3 S = GetSubsurface(Frag.Normal, L, Mat.Subsurface, Mat.Scattering);
+		Result += float4(Light.Lighting * (R + S) * A, A);
+	}
+
+	return Result;
+};
\ No newline at end of file
@@ -7,6 +7,11 @@
 #include "vengeance.h"
 #include <vitex/network/http.h>
 #include <sstream>
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 #define CONTENT_BLOCKED_WAIT_MS 50
 
 namespace vitex
@@ -61,7 +66,7 @@ namespace vitex
 
 		float animator_state::get_timeline(core::timer* timing)const
 		{
-			return compute::mathf::min(time + rate * timing->get_step(), get_seconds_duration());
+			return compute::mathf::min(time + rate * (float)timing->get_step() * (float)std::max<size_t>(span, 1), get_seconds_duration());
 		}
 		float animator_state::get_seconds_duration() const
 		{
@@ -80,6 +85,33 @@ namespace vitex
 			return !paused && frame >= 0 && clip >= 0;
 		}
 
+		animation_tier animation_policy::get_tier(float distance, float radius, bool visible) const
+		{
+			if (!visible && freeze_invisible)
+				return animation_tier::frozen;
+
+			float scaled = distance / std::max(radius, 1.0f);
+			for (size_t i = 0; i < (size_t)animation_tier::frozen; i++)
+			{
+				if (scaled <= distances[i])
+					return (animation_tier)i;
+			}
+
+			return animation_tier::frozen;
+		}
+		size_t animation_policy::get_interval(animation_tier tier) const
+		{
+			if (tier == animation_tier::frozen)
+				return 0;
+
+			return std::max<size_t>(intervals[(size_t)tier], 1);
+		}
+		bool animation_policy::is_ticking(animation_tier tier, size_t frame, size_t seed) const
+		{
+			size_t interval = get_interval(tier);
+			return interval > 0 && (frame + seed) % interval == 0;
+		}
+
 		void viewer::set(const trigonometry::matrix4x4& _View, const trigonometry::matrix4x4& _Projection, const trigonometry::vector3& _Position, float _Fov, float _Ratio, float _Near, float _Far, render_culling _Type)
 		{
 			set(_View, _Projection, _Position, -_View.rotation_euler(), _Fov, _Ratio, _Near, _Far, _Type);
@@ -1189,6 +1221,13 @@ namespace vitex
 			for (auto* item : meshes)
 				core::memory::release(item);
 			meshes.clear();
+
+			for (auto& next : levels)
+			{
+				for (auto* item : next.meshes)
+					core::memory::release(item);
+			}
+			levels.clear();
 		}
 		graphics::mesh_buffer* model::find_mesh(const std::string_view& name)
 		{
@@ -1200,6 +1239,31 @@ namespace vitex
 
 			return nullptr;
 		}
+		graphics::mesh_buffer* model::get_level_mesh(size_t index, size_t level) const
+		{
+			VI_ASSERT(index < meshes.size(), "mesh index outside of range");
+			for (size_t i = std::min(level, levels.size()); i > 0; i--)
+			{
+				auto& next = levels[i - 1].meshes;
+				if (index < next.size() && next[index] != nullptr)
+					return next[index];
+			}
+
+			return meshes[index];
+		}
+		size_t model::get_level(float size, size_t current, float hysteresis) const
+		{
+			size_t coarse = 0, fine = 0;
+			for (auto& next : levels)
+			{
+				if (size < next.size * (1.0f - hysteresis))
+					++coarse;
+				if (size < next.size * (1.0f + hysteresis))
+					++fine;
+			}
+
+			return std::min(std::max(current, coarse), fine);
+		}
 
 		skin_model::skin_model() noexcept
 		{
@@ -1298,13 +1362,52 @@ namespace vitex
 			return nullptr;
 		}
 
-		skin_animation::skin_animation(core::vector<trigonometry::skin_animator_clip>&& data) noexcept : clips(std::move(data))
+		skin_animation::skin_animation(core::vector<trigonometry::skin_animator_clip>&& data) noexcept : clips(std::move(data)), restored(false)
 		{
+			compressed.reserve(clips.size());
+			for (auto& clip : clips)
+			{
+				compressed.push_back(trigonometry::skin_animator_compressed_clip::compress(clip));
+				for (auto& key : clip.keys)
+				{
+					key.pose.clear();
+					key.pose.shrink_to_fit();
+				}
+			}
 		}
 		const core::vector<trigonometry::skin_animator_clip>& skin_animation::get_clips()
 		{
+			core::umutex<std::mutex> unique(exclusive);
+			if (restored)
+				return clips;
+
+			for (size_t i = 0; i < clips.size() && i < compressed.size(); i++)
+			{
+				auto& clip = clips[i];
+				for (size_t j = 0; j < clip.keys.size(); j++)
+					compressed[i].sample_frame(j, clip.keys[j].pose);
+			}
+
+			restored = true;
 			return clips;
 		}
+		const core::vector<trigonometry::skin_animator_compressed_clip>& skin_animation::get_compressed_clips()
+		{
+			return compressed;
+		}
+		size_t skin_animation::get_memory_usage() const
+		{
+			size_t size = 0;
+			for (auto& clip : compressed)
+				size += clip.get_memory_usage();
+			for (auto& clip : clips)
+			{
+				size += clip.keys.size() * sizeof(trigonometry::skin_animator_key);
+				for (auto& key : clip.keys)
+					size += key.pose.size() * sizeof(trigonometry::animator_key);
+			}
+			return size;
+		}
 		bool skin_animation::is_valid()
 		{
 			return !clips.empty();
@@ -1467,7 +1570,268 @@ namespace vitex
 			return scene;
 		}
 
-		component::component(entity* reference, actor_set rule) noexcept : parent(reference), set((size_t)rule), indexed(false), active(true)
+		slab_allocator::slab_allocator(size_t new_element_size, size_t new_page_elements) noexcept : free_list(nullptr), element_size(std::max(sizeof(void*), new_element_size)), page_elements(std::max<size_t>(1, new_page_elements))
+		{
+		}
+		slab_allocator::~slab_allocator() noexcept
+		{
+			for (auto* page : pages)
+				core::memory::deallocate(page);
+		}
+		void slab_allocator::reserve(size_t count)
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			size_t available = 0;
+			for (void* next = free_list; next != nullptr && available < count; next = *(void**)next)
+				++available;
+
+			if (available < count)
+				allocate_page(std::max(page_elements, count - available));
+		}
+		void* slab_allocator::allocate()
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			if (!free_list)
+				allocate_page(page_elements);
+
+			void* address = free_list;
+			free_list = *(void**)address;
+			return address;
+		}
+		void slab_allocator::deallocate(void* address)
+		{
+			if (!address)
+				return;
+
+			core::umutex<std::mutex> unique(exclusive);
+			*(void**)address = free_list;
+			free_list = address;
+		}
+		size_t slab_allocator::get_element_size() const
+		{
+			return element_size;
+		}
+		void slab_allocator::allocate_page(size_t count)
+		{
+			char* page = core::memory::allocate<char>(element_size * count);
+			pages.push_back(page);
+
+			for (size_t i = count; i-- > 0;)
+			{
+				void* address = page + element_size * i;
+				*(void**)address = free_list;
+				free_list = address;
+			}
+		}
+		void* slab_allocator::allocate(size_t size)
+		{
+			slab_allocator* slab = get(size);
+			return slab ? slab->allocate() : core::memory::allocate<char>(size);
+		}
+		void slab_allocator::deallocate(void* address, size_t size)
+		{
+			slab_allocator* slab = get(size);
+			if (slab != nullptr)
+				slab->deallocate(address);
+			else
+				core::memory::deallocate(address);
+		}
+		slab_allocator* slab_allocator::get(size_t size)
+		{
+			static slab_allocator** slabs = []()
+			{
+				slab_allocator** result = new slab_allocator*[SLAB_CLASSES];
+				for (size_t i = 0; i < SLAB_CLASSES; i++)
+					result[i] = new slab_allocator((i + 1) * SLAB_ALIGNMENT);
+				return result;
+			}();
+
+			size_t index = (size + SLAB_ALIGNMENT - 1) / SLAB_ALIGNMENT;
+			return index > 0 && index <= SLAB_CLASSES ? slabs[index - 1] : nullptr;
+		}
+
+		frame_profiler::scope::scope(const char* new_name, uint64_t new_tag) noexcept : target(nullptr), name(new_name), tag(new_tag), begin(0)
+		{
+			frame_profiler* base = frame_profiler::get();
+			if (!base->is_enabled())
+				return;
+
+			target = base->get_thread_zones();
+			++target->depth;
+			begin = frame_profiler::get_ticks();
+		}
+		frame_profiler::scope::~scope() noexcept
+		{
+			if (!target)
+				return;
+
+			uint64_t end = frame_profiler::get_ticks();
+			uint64_t index = target->head.load(std::memory_order_relaxed);
+			auto& sequence = target->sequences[index % PROFILER_ZONES];
+			auto& next = target->zones[index % PROFILER_ZONES];
+			sequence.store(index * 2 + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			next.name = name;
+			next.tag = tag;
+			next.begin = begin;
+			next.end = end;
+			next.depth = --target->depth;
+			sequence.store(index * 2 + 2, std::memory_order_release);
+			target->head.store(index + 1, std::memory_order_release);
+		}
+
+		frame_profiler::frame_profiler() noexcept : enabled(false)
+		{
+			epoch.time = std::chrono::high_resolution_clock::now();
+			epoch.ticks = get_ticks();
+		}
+		frame_profiler::~frame_profiler() noexcept
+		{
+			for (auto* next : threads)
+				core::memory::deinit(next);
+			threads.clear();
+		}
+		void frame_profiler::set_enabled(bool value)
+		{
+			if (value && !enabled)
+				clear();
+			enabled = value;
+		}
+		void frame_profiler::clear()
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			epoch.time = std::chrono::high_resolution_clock::now();
+			epoch.ticks = get_ticks();
+			frame.begin = frame.end = epoch.ticks;
+		}
+		void frame_profiler::next_frame()
+		{
+			if (!enabled)
+				return;
+
+			core::umutex<std::mutex> unique(exclusive);
+			frame.begin = frame.end;
+			frame.end = get_ticks();
+		}
+		void frame_profiler::summarize(core::vector<zone_summary>& output)
+		{
+			output.clear();
+			core::umutex<std::mutex> unique(exclusive);
+			if (frame.begin >= frame.end)
+				return;
+
+			double ticks = get_ticks_per_microsecond();
+			for (auto* next : threads)
+			{
+				uint64_t head = next->head.load(std::memory_order_acquire);
+				uint64_t tail = head > PROFILER_ZONES ? head - PROFILER_ZONES : 0;
+				for (uint64_t i = tail; i < head; i++)
+				{
+					zone item;
+					if (!get_zone(next, i, item) || item.begin < frame.begin || item.end > frame.end || item.end < item.begin)
+						continue;
+
+					auto it = std::find_if(output.begin(), output.end(), [&item](const zone_summary& other) { return other.name == item.name && other.depth == item.depth; });
+					if (it == output.end())
+					{
+						zone_summary summary;
+						summary.name = item.name;
+						summary.depth = item.depth;
+						it = output.insert(output.end(), summary);
+					}
+
+					double duration = (double)(item.end - item.begin) / ticks;
+					it->total += duration;
+					it->max = std::max(it->max, duration);
+					++it->calls;
+				}
+			}
+
+			VI_SORT(output.begin(), output.end(), [](const zone_summary& a, const zone_summary& b)
+			{
+				return a.depth == b.depth ? a.total > b.total : a.depth < b.depth;
+			});
+		}
+		core::string frame_profiler::export_chrome_trace()
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			double ticks = get_ticks_per_microsecond();
+			core::string_stream stream;
+			stream << "{\"traceEvents\":[";
+
+			bool first = true;
+			for (auto* next : threads)
+			{
+				stream << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << next->thread << ",\"args\":{\"name\":\"thread " << next->thread << "\"}}";
+				first = false;
+
+				uint64_t head = next->head.load(std::memory_order_acquire);
+				uint64_t tail = head > PROFILER_ZONES ? head - PROFILER_ZONES : 0;
+				for (uint64_t i = tail; i < head; i++)
+				{
+					zone item;
+					if (!get_zone(next, i, item) || item.begin < epoch.ticks || item.end < item.begin)
+						continue;
+
+					stream << ",{\"name\":\"" << item.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << next->thread;
+					stream << ",\"ts\":" << (double)(item.begin - epoch.ticks) / ticks << ",\"dur\":" << (double)(item.end - item.begin) / ticks;
+					if (item.tag > 0)
+						stream << ",\"args\":{\"tag\":" << item.tag << "}";
+					stream << "}";
+				}
+			}
+
+			stream << "]}";
+			return stream.str();
+		}
+		double frame_profiler::get_ticks_per_microsecond() const
+		{
+			uint64_t ticks = get_ticks() - epoch.ticks;
+			double elapsed = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - epoch.time).count();
+			return ticks > 0 && elapsed > 0.0 ? (double)ticks / elapsed : 1.0;
+		}
+		bool frame_profiler::is_enabled() const
+		{
+			return enabled.load(std::memory_order_relaxed);
+		}
+		frame_profiler::thread_zones* frame_profiler::get_thread_zones()
+		{
+			static thread_local thread_zones* zones = nullptr;
+			if (zones != nullptr)
+				return zones;
+
+			core::umutex<std::mutex> unique(exclusive);
+			zones = core::memory::init<thread_zones>();
+			zones->thread = (uint32_t)threads.size();
+			threads.push_back(zones);
+			return zones;
+		}
+		bool frame_profiler::get_zone(thread_zones* base, uint64_t index, zone& output)
+		{
+			auto& sequence = base->sequences[index % PROFILER_ZONES];
+			uint64_t expected = index * 2 + 2;
+			if (sequence.load(std::memory_order_acquire) != expected)
+				return false;
+
+			output = base->zones[index % PROFILER_ZONES];
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return sequence.load(std::memory_order_relaxed) == expected;
+		}
+		uint64_t frame_profiler::get_ticks()
+		{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+			return (uint64_t)__rdtsc();
+#else
+			return (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+#endif
+		}
+		frame_profiler* frame_profiler::get()
+		{
+			static frame_profiler* base = new frame_profiler();
+			return base;
+		}
+
+		component::component(entity* reference, actor_set rule) noexcept : parent(reference), set((size_t)rule), pending(0), indexed(false), active(true)
 		{
 			VI_ASSERT(reference != nullptr, "entity should be set");
 		}
@@ -1480,6 +1844,14 @@ namespace vitex
 		void component::serialize(core::schema* node)
 		{
 		}
+		bool component::serialize_binary(core::string& output)
+		{
+			return false;
+		}
+		bool component::deserialize_binary(const std::string_view& input)
+		{
+			return false;
+		}
 		void component::activate(component* init)
 		{
 		}
@@ -1550,6 +1922,15 @@ namespace vitex
 			return parent;
 		}
 
+		void* component::operator new(size_t size)
+		{
+			return slab_allocator::allocate(size);
+		}
+		void component::operator delete(void* address, size_t size)
+		{
+			slab_allocator::deallocate(address, size);
+		}
+
 		entity::entity(scene_graph* new_scene) noexcept : transform(new trigonometry::transform(this)), scene(new_scene), active(false)
 		{
 			VI_ASSERT(scene != nullptr, "entity should be created within a scene");
@@ -1569,6 +1950,14 @@ namespace vitex
 
 			core::memory::release(transform);
 		}
+		void* entity::operator new(size_t size)
+		{
+			return slab_allocator::allocate(size);
+		}
+		void entity::operator delete(void* address, size_t size)
+		{
+			slab_allocator::deallocate(address, size);
+		}
 		void entity::set_name(const std::string_view& value)
 		{
 			type.name = value;
@@ -1617,8 +2006,8 @@ namespace vitex
 		}
 		void entity::remove_component(uint64_t id)
 		{
-			core::unordered_map<uint64_t, component*>::iterator it = type.components.find(id);
-			if (it == type.components.end())
+			auto it = find_component(id);
+			if (it == type.components.end() || it->first != id)
 				return;
 
 			component* base = it->second;
@@ -1658,7 +2047,7 @@ namespace vitex
 			in->active = false;
 			in->parent = this;
 
-			type.components.insert({ in->get_id(), in });
+			type.components.emplace(find_component(in->get_id()), in->get_id(), in);
 			scene->transaction([this, in]()
 			{
 				for (auto& component : type.components)
@@ -1671,12 +2060,19 @@ namespace vitex
 		}
 		component* entity::get_component(uint64_t id)
 		{
-			core::unordered_map<uint64_t, component*>::iterator it = type.components.find(id);
-			if (it != type.components.end())
+			auto it = find_component(id);
+			if (it != type.components.end() && it->first == id)
 				return it->second;
 
 			return nullptr;
 		}
+		entity::component_array::iterator entity::find_component(uint64_t id)
+		{
+			return std::lower_bound(type.components.begin(), type.components.end(), id, [](const std::pair<uint64_t, component*>& a, uint64_t b)
+			{
+				return a.first < b;
+			});
+		}
 		size_t entity::get_components_count() const
 		{
 			return type.components.size();
@@ -1745,6 +2141,37 @@ namespace vitex
 			float max = (radius.x > radius.y ? radius.x : radius.y);
 			return (max > radius.z ? radius.z : max);
 		}
+		uint64_t entity::get_sort_key(geo_category category, uint64_t slot, uint64_t geometry, float distance)
+		{
+			uint32_t depth = 0;
+			if (distance > 0.0f)
+				memcpy(&depth, &distance, sizeof(uint32_t));
+
+			uint64_t key = (uint64_t)category << 62;
+			if (category == geo_category::opaque)
+				return key | ((slot & 0xFFFFF) << 42) | ((geometry & 0xFFFF) << 26) | (uint64_t)(depth >> 5);
+
+			if (category == geo_category::transparent || category == geo_category::additive)
+				depth = ~depth;
+
+			return key | ((uint64_t)depth << 30) | (slot & 0x3FFFFFFF);
+		}
+		uint64_t entity::get_sort_geometry(void* instance)
+		{
+			uint64_t hash = (uint64_t)(uintptr_t)instance;
+			hash ^= hash >> 33;
+			hash *= 0xFF51AFD7ED558CCDull;
+			hash ^= hash >> 33;
+			return instance ? (hash & 0xFFFF) : 0;
+		}
+		uint64_t entity::get_sort_slot(drawable* a)
+		{
+			return (uint64_t)(a->get_slot() + 1);
+		}
+		uint64_t entity::get_sort_slot(component* a)
+		{
+			return 0;
+		}
 
 		drawable::drawable(entity* ref, actor_set rule, uint64_t hash) noexcept : component(ref, rule | actor_set::cullable | actor_set::drawable | actor_set::message), category(geo_category::opaque), source(hash), overlapping(1.0f), constant(true)
 		{
@@ -2136,6 +2563,40 @@ namespace vitex
 		{
 			base_material = nullptr;
 		}
+		void render_system::clear_casters()
+		{
+			for (auto& bins : casters.lists)
+				bins.second.ready = false;
+
+			casters.volumes.clear();
+			casters.current = std::numeric_limits<size_t>::max();
+			casters.cursor = 0;
+		}
+		void render_system::add_caster_volume(const trigonometry::vector3& position, float radius)
+		{
+			rs_caster_volume volume;
+			volume.position = position;
+			volume.radius = radius;
+			volume.culling = render_culling::depth_cube;
+
+			trigonometry::bounding bounds(position - radius, position + radius);
+			if (casters.volumes.empty())
+				casters.bounds = bounds;
+			else
+				casters.bounds.merge(casters.bounds, bounds);
+			casters.volumes.push_back(volume);
+		}
+		void render_system::add_caster_volume(const trigonometry::vector3& position, float radius, const trigonometry::matrix4x4& view_projection)
+		{
+			add_caster_volume(position, radius);
+			auto& volume = casters.volumes.back();
+			volume.frustum = trigonometry::frustum6p(view_projection);
+			volume.culling = render_culling::depth;
+		}
+		void render_system::next_caster_volume()
+		{
+			casters.current = (casters.cursor < casters.volumes.size() ? casters.cursor++ : std::numeric_limits<size_t>::max());
+		}
 		void render_system::fetch_visibility(component* base, visibility_query& data)
 		{
 			auto* varying = (drawable*)base;
@@ -2169,26 +2630,38 @@ namespace vitex
 
 			for (auto& next : renderers)
 			{
-				if (next->active)
-					next->begin_pass(time);
+				if (!next->active)
+					continue;
+
+				VI_PROFILE("renderer::begin_pass", next->get_id());
+				next->begin_pass(time);
 			}
 
 			for (auto& next : renderers)
 			{
-				if (next->active)
-					count += next->render_prepass(time);
+				if (!next->active)
+					continue;
+
+				VI_PROFILE("renderer::render_prepass", next->get_id());
+				count += next->render_prepass(time);
 			}
 
 			for (auto& next : renderers)
 			{
-				if (next->active)
-					count += next->render_pass(time);
+				if (!next->active)
+					continue;
+
+				VI_PROFILE("renderer::render_pass", next->get_id());
+				count += next->render_pass(time);
 			}
 
 			for (auto& next : renderers)
 			{
-				if (next->active)
-					next->end_pass();
+				if (!next->active)
+					continue;
+
+				VI_PROFILE("renderer::end_pass", next->get_id());
+				next->end_pass();
 			}
 
 			state.target = last_target;
@@ -2415,6 +2888,50 @@ namespace vitex
 		{
 			return scene->get_storage(section);
 		}
+		core::vector<void*>& render_system::get_casters(uint64_t section)
+		{
+			VI_ASSERT(casters.current < casters.volumes.size(), "caster volume should be selected");
+			auto& bins = casters.lists[section];
+			if (bins.ready)
+				return bins.items[casters.current];
+
+			VI_PROFILE("render_system::casters");
+			bins.ready = true;
+			bins.items.resize(casters.volumes.size());
+			for (auto& items : bins.items)
+				items.clear();
+
+			auto& storage = get_storage_wrapper(section);
+			indexing.stack.clear();
+			if (!storage.index.empty())
+				indexing.stack.push_back(storage.index.get_root());
+
+			while (!indexing.stack.empty())
+			{
+				auto& next = storage.index.get_node(indexing.stack.back());
+				indexing.stack.pop_back();
+				if (!casters.bounds.overlaps(next.bounds))
+					continue;
+
+				if (!next.is_leaf())
+				{
+					indexing.stack.push_back(next.left);
+					indexing.stack.push_back(next.right);
+					continue;
+				}
+				else if (!next.item)
+					continue;
+
+				for (size_t i = 0; i < casters.volumes.size(); i++)
+				{
+					auto& volume = casters.volumes[i];
+					if (next.bounds.overlaps_sphere(volume.position, volume.radius) && (volume.culling != render_culling::depth || volume.frustum.overlaps_aabb(next.bounds)))
+						bins.items[i].push_back(next.item);
+				}
+			}
+
+			return bins.items[casters.current];
+		}
 		void render_system::watch(core::vector<core::promise<void>>&& tasks)
 		{
 			scene->watch(task_type::rendering, std::move(tasks));
@@ -3069,6 +3586,13 @@ namespace vitex
 			core::memory::release(quad);
 		}
 
+		static double measure_step(std::chrono::high_resolution_clock::time_point& time)
+		{
+			auto now = std::chrono::high_resolution_clock::now();
+			double duration = std::chrono::duration<double>(now - time).count();
+			time = now;
+			return duration;
+		}
 		template <typename t>
 		static void upgrade_buffer_by_rate(core::pool<t>& storage, float grow)
 		{
@@ -3206,6 +3730,9 @@ namespace vitex
 			display.layout = nullptr;
 			loading.defaults = nullptr;
 
+			for (auto& tier : animating.tiers)
+				tier = 0;
+
 			conf.add_ref();
 			configure(conf);
 			script_hook();
@@ -3358,21 +3885,40 @@ namespace vitex
 		{
 			auto* device = conf.shared.device;
 			VI_ASSERT(device != nullptr, "graphics device should be set");
-			graphics::mapped_subresource stream;
-			if (!device->map(display.material_buffer, graphics::resource_map::write_discard, &stream))
+			if (!display.material_buffer)
 				return;
 
-			size_t size = 0;
-			subsurface* array = (subsurface*)stream.pointer;
-			auto begin = materials.begin(), end = materials.end();
-			for (auto it = begin; it != end; ++it)
+			surfaces.changes.clear();
+			for (auto* next : materials)
 			{
-				subsurface& next = array[size];
-				(*it)->slot = size++;
-				next = (*it)->surface;
+				if (next->slot >= surfaces.cache.size())
+					continue;
+
+				subsurface& cache = surfaces.cache[next->slot];
+				if (!memcmp(&cache, &next->surface, sizeof(subsurface)))
+					continue;
+
+				cache = next->surface;
+				surfaces.changes.push_back(next->slot);
 			}
 
-			device->unmap(display.material_buffer, &stream);
+			if (surfaces.changes.empty())
+				return;
+
+			std::sort(surfaces.changes.begin(), surfaces.changes.end());
+			size_t first = surfaces.changes.front(), last = first;
+			for (size_t i = 1; i <= surfaces.changes.size(); i++)
+			{
+				if (i < surfaces.changes.size() && surfaces.changes[i] <= last + 4)
+				{
+					last = surfaces.changes[i];
+					continue;
+				}
+
+				device->update_buffer(display.material_buffer, surfaces.cache.data() + first, sizeof(subsurface) * first, sizeof(subsurface) * (last - first + 1));
+				if (i < surfaces.changes.size())
+					first = last = surfaces.changes[i];
+			}
 		}
 		void scene_graph::submit()
 		{
@@ -3399,20 +3945,31 @@ namespace vitex
 		{
 			VI_ASSERT(time != nullptr, "time should be set");
 			VI_MEASURE(core::timings::pass);
+			VI_PROFILE("scene_graph::dispatch");
 
+			auto timing = std::chrono::high_resolution_clock::now();
 			step_events();
+			statistics.steps[(size_t)scene_step::events] = measure_step(timing);
 			step_transactions();
+			statistics.steps[(size_t)scene_step::transactions] = measure_step(timing);
 			step_gameplay(time);
+			statistics.steps[(size_t)scene_step::gameplay] = measure_step(timing);
 			step_simulate(time);
+			statistics.steps[(size_t)scene_step::simulate] = measure_step(timing);
 			step_animate(time);
+			statistics.steps[(size_t)scene_step::animate] = measure_step(timing);
 			step_synchronize(time);
+			statistics.steps[(size_t)scene_step::synchronize] = measure_step(timing);
 			step_indexing();
+			statistics.steps[(size_t)scene_step::indexing] = measure_step(timing);
 			step_finalize();
+			statistics.steps[(size_t)scene_step::finalize] = measure_step(timing);
 		}
 		void scene_graph::publish(core::timer* time)
 		{
 			VI_ASSERT(time != nullptr, "timer should be set");
 			VI_MEASURE((uint64_t)core::timings::frame * 2);
+			VI_PROFILE("scene_graph::publish");
 
 			auto* base = (components::camera*)camera.load();
 			auto* renderer = (base ? base->get_renderer() : nullptr);
@@ -3420,14 +3977,17 @@ namespace vitex
 			statistics.sorting = 0;
 			statistics.instances = 0;
 			statistics.draw_calls = 0;
+			statistics.steps[(size_t)scene_step::publish] = 0.0;
 
 			if (!renderer)
 				return;
 
+			auto timing = std::chrono::high_resolution_clock::now();
 			fill_material_buffers();
 			set_mrt(target_type::main, true);
 			renderer->restore_view_buffer(nullptr);
 			statistics.draw_calls += renderer->render(time, render_state::geometry, render_opt::none);
+			statistics.steps[(size_t)scene_step::publish] = measure_step(timing);
 		}
 		void scene_graph::publish_and_submit(core::timer* time, float r, float g, float b, bool is_parallel)
 		{
@@ -3461,12 +4021,14 @@ namespace vitex
 			VI_ASSERT(time != nullptr, "timer should be set");
 			VI_ASSERT(simulator != nullptr, "simulator should be set");
 			VI_MEASURE(core::timings::frame);
+			VI_PROFILE("scene_graph::step_simulate");
 
 			if (!active)
 				return;
 
 			watch(task_type::processing, parallel::enqueue([this, time]()
 			{
+				VI_PROFILE("simulator::simulate_step");
 				simulator->simulate_step(time->get_elapsed());
 			}));
 		}
@@ -3474,6 +4036,7 @@ namespace vitex
 		{
 			VI_ASSERT(time != nullptr, "timer should be set");
 			VI_MEASURE(core::timings::frame);
+			VI_PROFILE("scene_graph::step_synchronize");
 
 			auto& storage = actors[(size_t)actor_type::synchronize];
 			if (!storage.empty())
@@ -3488,6 +4051,16 @@ namespace vitex
 		{
 			VI_ASSERT(time != nullptr, "timer should be set");
 			VI_MEASURE(core::timings::frame);
+			VI_PROFILE("scene_graph::step_animate");
+
+			for (size_t i = 0; i < (size_t)animation_tier::count; i++)
+				statistics.animators[i] = animating.tiers[i].exchange(0);
+
+			auto* base = (components::camera*)camera.load();
+			auto* renderer = (base ? base->get_renderer() : nullptr);
+			animating.valid = conf.animation.enabled && renderer != nullptr;
+			if (animating.valid)
+				animating.view = renderer->view;
 
 			auto& storage = actors[(size_t)actor_type::animate];
 			if (active && !storage.empty())
@@ -3513,6 +4086,7 @@ namespace vitex
 		{
 			VI_ASSERT(time != nullptr, "timer should be set");
 			VI_MEASURE(core::timings::pass);
+			VI_PROFILE("scene_graph::step_gameplay");
 
 			auto& storage = actors[(size_t)actor_type::update];
 			if (active && !storage.empty())
@@ -3526,6 +4100,7 @@ namespace vitex
 		void scene_graph::step_transactions()
 		{
 			VI_MEASURE(core::timings::pass);
+			VI_PROFILE("scene_graph::step_transactions");
 			if (transactions.empty())
 				return;
 
@@ -3541,6 +4116,7 @@ namespace vitex
 		void scene_graph::step_events()
 		{
 			VI_MEASURE(core::timings::pass);
+			VI_PROFILE("scene_graph::step_events");
 			if (!events.empty())
 				VI_TRACE("[scene] resolve %" PRIu64 " events on 0x%" PRIXPTR, (uint64_t)events.size(), (void*)this);
 
@@ -3554,6 +4130,7 @@ namespace vitex
 		void scene_graph::step_indexing()
 		{
 			VI_MEASURE(core::timings::frame);
+			VI_PROFILE("scene_graph::step_indexing");
 			if (!camera.load() || dirty.empty())
 				return;
 
@@ -3561,6 +4138,10 @@ namespace vitex
 			auto end = dirty.end();
 			dirty.clear();
 
+			size_t threads = parallel::get_threads();
+			if (thread_changes.size() < threads)
+				thread_changes.resize(threads);
+
 			watch(task_type::processing, parallel::for_each(begin, end, THRESHOLD_PER_ELEMENT, [this](entity* next)
 			{
 				next->transform->synchronize();
@@ -3569,43 +4150,51 @@ namespace vitex
 				if (next->type.components.empty())
 					return;
 
-				core::umutex<std::mutex> unique(exclusive);
+				auto& queue = thread_changes[parallel::get_thread_index()];
 				for (auto& item : *next)
 				{
 					if (item.second->is_cullable())
-						changes[item.second->get_id()].insert(item.second);
+						queue.push_back(item.second);
 				}
 			}));
 		}
 		void scene_graph::step_finalize()
 		{
 			VI_MEASURE(core::timings::frame);
+			VI_PROFILE("scene_graph::step_finalize");
 
 			await(task_type::processing);
+			core::umutex<std::mutex> unique(exclusive);
+			for (auto& queue : thread_changes)
+			{
+				for (auto* base : queue)
+					enqueue_cosmos(base);
+				queue.clear();
+			}
+
 			if (!camera.load())
 				return;
 
 			for (auto& item : changes)
 			{
-				if (item.second.empty())
+				auto& queue = item.second;
+				if (queue.empty())
 					continue;
 
 				auto& storage = get_storage(item.first);
-				storage.index.reserve(item.second.size());
+				storage.index.reserve(queue.size());
 
-				size_t count = 0;
-				for (auto it = item.second.begin(); it != item.second.end(); ++it)
+				size_t count = std::min(queue.size(), std::max<size_t>(conf.max_updates, 1));
+				for (size_t i = 0; i < count; i++)
 				{
-					update_cosmos(storage, *it);
-					if (++count > conf.max_updates)
-					{
-						item.second.erase(item.second.begin(), it);
-						break;
-					}
+					component* base = queue[i];
+					base->pending = 0;
+					update_cosmos(storage, base);
 				}
 
-				if (count == item.second.size())
-					item.second.clear();
+				queue.erase(queue.begin(), queue.begin() + count);
+				for (size_t i = 0; i < queue.size(); i++)
+					queue[i]->pending = i + 1;
 			}
 		}
 		void scene_graph::set_camera(entity* new_camera)
@@ -3655,6 +4244,7 @@ namespace vitex
 			{
 				if (*it == value)
 				{
+					surfaces.free.push_back(value->slot);
 					materials.remove_at(it);
 					break;
 				}
@@ -3782,13 +4372,13 @@ namespace vitex
 
 			return true;
 		}
-		void scene_graph::clone_entities(entity* instance, core::vector<entity*>* array)
+		void scene_graph::clone_entities(entity* instance, core::vector<entity*>* array, bool publish)
 		{
 			VI_ASSERT(instance != nullptr, "entity should be set");
 			VI_ASSERT(array != nullptr, "array should be set");
 			VI_TRACE("[scene] clone entity 0x%" PRIXPTR " on 0x%" PRIXPTR, (void*)instance, (void*)this);
 
-			entity* clone = clone_entity_instance(instance);
+			entity* clone = clone_entity_instance(instance, publish);
 			array->push_back(clone);
 
 			trigonometry::transform* root = clone->transform->get_root();
@@ -3804,7 +4394,7 @@ namespace vitex
 			for (auto& child : childs)
 			{
 				size_t offset = array->size();
-				clone_entities((entity*)child->user_data, array);
+				clone_entities((entity*)child->user_data, array, publish);
 				for (size_t j = offset; j < array->size(); j++)
 				{
 					entity* next = (*array)[j];
@@ -4026,6 +4616,31 @@ namespace vitex
 			events.push(std::move(next));
 			return true;
 		}
+		bool scene_graph::tick_animation(entity* target, animator_state& state, core::timer* time)
+		{
+			VI_ASSERT(target != nullptr, "entity should be set");
+			VI_ASSERT(time != nullptr, "timer should be set");
+			if (!animating.valid)
+			{
+				++animating.tiers[(size_t)animation_tier::full];
+				state.span = 1;
+				state.phase = 0;
+				return true;
+			}
+
+			auto& view = animating.view;
+			float distance = target->get_transform()->get_position().distance(view.position);
+			bool visible = distance <= view.far_plane && trigonometry::geometric::is_cube_in_frustum(target->get_box() * view.view_projection, 1.65f);
+			animation_tier tier = conf.animation.get_tier(distance, target->get_radius(), visible);
+			++animating.tiers[(size_t)tier];
+
+			if (!conf.animation.is_ticking(tier, (size_t)time->get_frame_index(), (size_t)((uintptr_t)target >> 4)))
+				return false;
+
+			state.span = conf.animation.get_interval(tier);
+			state.phase = 0;
+			return true;
+		}
 		void scene_graph::load_resource(uint64_t id, component* context, const std::string_view& path, const core::variant_args& keys, std::function<void(expects_content<void*>&&)>&& callback)
 		{
 			VI_ASSERT(conf.shared.content != nullptr, "content manager should be set");
@@ -4251,14 +4866,17 @@ namespace vitex
 		void scene_graph::generate_material_buffer()
 		{
 			VI_TRACE("[scene] generate material buffer %" PRIu64 "m on 0x%" PRIXPTR, (uint64_t)materials.capacity(), (void*)this);
+			surfaces.cache.resize(std::max<size_t>(materials.capacity(), surfaces.top));
+
 			graphics::element_buffer::desc f = graphics::element_buffer::desc();
-			f.access_flags = graphics::cpu_access::write;
+			f.access_flags = graphics::cpu_access::none;
 			f.misc_flags = graphics::resource_misc::buffer_structured;
-			f.usage = graphics::resource_usage::dynamic;
+			f.usage = graphics::resource_usage::defaults;
 			f.bind_flags = graphics::resource_bind::shader_input;
-			f.element_count = (uint32_t)materials.capacity();
+			f.element_count = (uint32_t)surfaces.cache.size();
 			f.element_width = sizeof(subsurface);
 			f.structure_byte_stride = f.element_width;
+			f.elements = (void*)surfaces.cache.data();
 
 			core::memory::release(display.material_buffer);
 			display.material_buffer = *conf.shared.device->create_element_buffer(f);
@@ -4338,7 +4956,7 @@ namespace vitex
 				return;
 
 			core::umutex<std::mutex> unique(exclusive);
-			changes[base->get_id()].insert(base);
+			enqueue_cosmos(base);
 		}
 		void scene_graph::clear_cosmos(component* base)
 		{
@@ -4347,7 +4965,7 @@ namespace vitex
 
 			uint64_t id = base->get_id();
 			core::umutex<std::mutex> unique(exclusive);
-			changes[id].erase(base);
+			dequeue_cosmos(base);
 
 			if (base->indexed)
 			{
@@ -4355,6 +4973,28 @@ namespace vitex
 				storage.index.remove_item((void*)base);
 			}
 		}
+		void scene_graph::enqueue_cosmos(component* base)
+		{
+			if (base->pending > 0)
+				return;
+
+			auto& queue = changes[base->get_id()];
+			queue.push_back(base);
+			base->pending = queue.size();
+		}
+		void scene_graph::dequeue_cosmos(component* base)
+		{
+			if (!base->pending)
+				return;
+
+			auto& queue = changes[base->get_id()];
+			component* last = queue.back();
+			size_t index = base->pending - 1;
+			queue[index] = last;
+			last->pending = index + 1;
+			queue.pop_back();
+			base->pending = 0;
+		}
 		void scene_graph::update_cosmos(sparse_index& storage, component* base)
 		{
 			if (base->active)
@@ -4446,7 +5086,21 @@ namespace vitex
 			}
 			else
 			{
+				for (auto* next : materials)
+				{
+					if (next == base)
+						return true;
+				}
+
 				VI_TRACE("[scene] add material %s on 0x%" PRIXPTR, base->name.c_str(), (void*)this);
+				if (surfaces.free.empty())
+					base->slot = surfaces.top++;
+				else
+				{
+					base->slot = surfaces.free.back();
+					surfaces.free.pop_back();
+				}
+
 				base->scene = this;
 				materials.add_if_not_exists(base);
 				mutate(base, "push");
@@ -4539,6 +5193,12 @@ namespace vitex
 
 			return *storage;
 		}
+		const sparse_index* scene_graph::find_storage(uint64_t section) const
+		{
+			core::umutex<std::mutex> unique(exclusive);
+			auto it = registry.find(section);
+			return it != registry.end() ? it->second : nullptr;
+		}
 		material* scene_graph::get_material(const std::string_view& name)
 		{
 			auto begin = materials.begin(), end = materials.end();
@@ -4572,7 +5232,7 @@ namespace vitex
 			component* data = get_camera();
 			return data ? data->parent : nullptr;
 		}
-		entity* scene_graph::clone_entity_instance(entity* entity)
+		entity* scene_graph::clone_entity_instance(entity* entity, bool publish)
 		{
 			VI_ASSERT(entity != nullptr, "entity should be set");
 			VI_MEASURE(core::timings::pass);
@@ -4581,17 +5241,19 @@ namespace vitex
 			instance->transform->copy(entity->transform);
 			instance->transform->user_data = instance;
 			instance->type.name = entity->type.name;
-			instance->type.components = entity->type.components;
+			instance->type.components.reserve(entity->type.components.size());
 
-			for (auto& it : instance->type.components)
+			for (auto& it : entity->type.components)
 			{
 				component* source = it.second;
-				it.second = source->copy(instance);
-				it.second->parent = instance;
-				it.second->active = source->active;
+				component* target = source->copy(instance);
+				target->parent = instance;
+				target->active = source->active;
+				instance->type.components.emplace_back(it.first, target);
 			}
 
-			add_entity(instance);
+			if (publish)
+				add_entity(instance);
 			return instance;
 		}
 		entity* scene_graph::clone_entity(entity* value)
@@ -4678,6 +5340,96 @@ namespace vitex
 			clone_entities(value, &array);
 			return array;
 		}
+		void scene_graph::spawn_entities(entity* prefab, size_t count, spawn_callback&& callback)
+		{
+			VI_ASSERT(prefab != nullptr, "prefab should be set");
+			VI_ASSERT(prefab->scene == this, "prefab should be created within this scene");
+			if (!count)
+				return;
+
+			prefab->add_ref();
+			core::umutex<std::mutex> unique(exclusive);
+			transactions.emplace([this, prefab, count, callback = std::move(callback)]() mutable
+			{
+				VI_MEASURE(core::timings::pass);
+				VI_TRACE("[scene] spawn %" PRIu64 " instances of entity 0x%" PRIXPTR " on 0x%" PRIXPTR, (uint64_t)count, (void*)prefab, (void*)this);
+
+				size_t hierarchy = 1 + prefab->transform->get_childs_count();
+				slab_allocator::get(sizeof(entity))->reserve(count * hierarchy);
+
+				core::vector<entity*> array;
+				array.reserve(count * hierarchy);
+				for (size_t i = 0; i < count; i++)
+					clone_entities(prefab, &array, false);
+
+				publish_entities(array);
+				prefab->release();
+				if (callback)
+					callback(std::move(array));
+			});
+		}
+		void scene_graph::publish_entities(core::vector<entity*>& array)
+		{
+			VI_MEASURE(core::timings::pass);
+			core::unordered_map<uint64_t, size_t> sections;
+			size_t actions[(size_t)actor_type::count] = { 0 };
+			for (auto* next : array)
+			{
+				for (auto& base : next->type.components)
+				{
+					++sections[base.first];
+					for (size_t i = 0; i < (size_t)actor_type::count; i++)
+					{
+						if (base.second->set & (size_t)(1 << i))
+							++actions[i];
+					}
+				}
+			}
+
+			if (entities.size() + array.size() + conf.grow_margin > entities.capacity())
+				upgrade_buffer_by_size(entities, entities.size() + array.size() + conf.grow_margin);
+
+			for (size_t i = 0; i < (size_t)actor_type::count; i++)
+			{
+				auto& storage = actors[i];
+				if (actions[i] > 0 && storage.size() + actions[i] + conf.grow_margin > storage.capacity())
+					upgrade_buffer_by_size(storage, storage.size() + actions[i] + conf.grow_margin);
+			}
+
+			for (auto& section : sections)
+			{
+				sparse_index* storage = registry[section.first];
+				VI_ASSERT(storage != nullptr, "component should be registered by composer");
+				if (storage->data.size() + section.second + conf.grow_margin > storage->data.capacity())
+					upgrade_buffer_by_size(storage->data, storage->data.size() + section.second + conf.grow_margin);
+				storage->index.reserve(storage->index.get_nodes_count() + section.second * 2);
+			}
+
+			for (auto* next : array)
+			{
+				entities.add(next);
+				next->active = true;
+				for (auto& base : next->type.components)
+					register_component(base.second, false);
+
+				watch_movement(next);
+				mutate(next, "push");
+			}
+
+			if (!camera.load())
+				return;
+
+			for (auto* next : array)
+			{
+				next->transform->synchronize();
+				next->update_bounds();
+				for (auto& base : next->type.components)
+				{
+					if (base.second->active && base.second->is_cullable())
+						update_cosmos(*registry[base.first], base.second);
+				}
+			}
+		}
 		core::vector<entity*> scene_graph::query_by_parent(entity* entity) const
 		{
 			core::vector<layer::entity*> array;
@@ -4706,7 +5458,15 @@ namespace vitex
 		}
 		core::vector<component*> scene_graph::query_by_position(uint64_t section, const trigonometry::vector3& position, float radius)
 		{
-			return query_by_area(section, position - radius * 0.5f, position + radius * 0.5f);
+			core::vector<component*> result;
+			trigonometry::cosmos::iterator context;
+			visit_by_sphere(section, context, position, radius, [&result](component* item)
+			{
+				result.push_back(item);
+				return true;
+			});
+
+			return result;
 		}
 		core::vector<component*> scene_graph::query_by_area(uint64_t section, const trigonometry::vector3& min, const trigonometry::vector3& max)
 		{
@@ -4766,6 +5526,17 @@ namespace vitex
 
 			return result;
 		}
+		size_t scene_graph::query_by_nearest(uint64_t section, trigonometry::cosmos::nearest_iterator& context, const trigonometry::vector3& position, size_t count, component** results, float* distances) const
+		{
+			const sparse_index* storage = find_storage(section);
+			if (!storage)
+				return 0;
+
+			return storage->index.query_nearest<component>(context, [&position](const trigonometry::bounding& bounds)
+			{
+				return bounds.get_distance(position);
+			}, count, results, distances);
+		}
 		core::vector<depth_cube_map*>& scene_graph::get_points_mapping()
 		{
 			return display.points;
@@ -4817,6 +5588,23 @@ namespace vitex
 
 			return true;
 		}
+		core::vector<entity*> scene_graph::add_entities(size_t count)
+		{
+			core::vector<entity*> array;
+			array.reserve(count);
+			for (size_t i = 0; i < count; i++)
+				array.push_back(new entity(this));
+
+			if (!array.empty())
+			{
+				transaction([this, array]() mutable
+				{
+					publish_entities(array);
+				});
+			}
+
+			return array;
+		}
 		bool scene_graph::has_entity(entity* entity) const
 		{
 			VI_ASSERT(entity != nullptr, "entity should be set");
@@ -4902,6 +5690,872 @@ namespace vitex
 			return device;
 		}
 
+		void scene_snapshot::capture(scene_graph* scene)
+		{
+			VI_ASSERT(scene != nullptr, "scene should be set");
+			VI_MEASURE(core::timings::intensive);
+			VI_PROFILE("scene_snapshot::capture");
+			scene->actualize();
+
+			idx_snapshot snapshot;
+			scene->make_snapshot(&snapshot);
+			scene->snapshot = &snapshot;
+
+			size_t count = scene->get_entities_count();
+			core::vector<entity_record> entities(count);
+			core::vector<component_record> components;
+			core::vector<uint32_t> offsets;
+			core::string strings, blocks, buffer;
+			components.reserve(count * 2);
+			offsets.reserve(count + 1);
+			offsets.push_back(0);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				entity* next = scene->get_entity(i);
+				auto* transform = next->get_transform();
+				auto& position = transform->get_position();
+				auto& rotation = transform->get_rotation();
+				auto& scale = transform->get_scale();
+				auto& record = entities[i];
+				memset(&record, 0, sizeof(record));
+
+				strings.append(next->get_name());
+				offsets.push_back((uint32_t)strings.size());
+				record.name = (uint32_t)(offsets.size() - 2);
+				record.position[0] = position.x; record.position[1] = position.y; record.position[2] = position.z;
+				record.rotation[0] = rotation.x; record.rotation[1] = rotation.y; record.rotation[2] = rotation.z;
+				record.scale[0] = scale.x; record.scale[1] = scale.y; record.scale[2] = scale.z;
+				record.scaling = transform->has_scaling() ? 1 : 0;
+				record.parent = -1;
+
+				auto* root = transform->get_root();
+				if (root != nullptr)
+				{
+					auto& space = transform->get_spacing();
+					record.pivot = 1;
+					record.pivot_position[0] = space.position.x; record.pivot_position[1] = space.position.y; record.pivot_position[2] = space.position.z;
+					record.pivot_rotation[0] = space.rotation.x; record.pivot_rotation[1] = space.rotation.y; record.pivot_rotation[2] = space.rotation.z;
+					record.pivot_scale[0] = space.scale.x; record.pivot_scale[1] = space.scale.y; record.pivot_scale[2] = space.scale.z;
+					memcpy(record.pivot_offset, space.offset.row, sizeof(record.pivot_offset));
+					if (root->user_data != nullptr)
+					{
+						auto it = snapshot.to.find((entity*)root->user_data);
+						if (it != snapshot.to.end())
+							record.parent = (int64_t)it->second;
+					}
+				}
+
+				record.components_offset = (uint32_t)components.size();
+				record.components_count = (uint32_t)next->get_components_count();
+				for (auto& item : *next)
+				{
+					component_record target;
+					memset(&target, 0, sizeof(target));
+					target.id = item.first;
+					target.active = item.second->is_active() ? 1 : 0;
+
+					buffer.clear();
+					if (item.second->serialize_binary(buffer))
+					{
+						target.format = block_format::binary;
+					}
+					else
+					{
+						core::uptr<core::schema> node = core::var::set::object();
+						item.second->serialize(*node);
+						write_schema(buffer, *node);
+						target.format = block_format::schema;
+					}
+
+					target.offset = (uint64_t)blocks.size();
+					target.size = (uint64_t)buffer.size();
+					blocks.append(buffer);
+					components.push_back(target);
+				}
+			}
+
+			scene->snapshot = nullptr;
+
+			header info;
+			memset(&info, 0, sizeof(info));
+			memcpy(info.magic, "VISS", sizeof(info.magic));
+			info.version = 1;
+			info.strings = (uint32_t)(offsets.size() - 1);
+			info.entities = (uint32_t)entities.size();
+			info.components = (uint32_t)components.size();
+			info.strings_size = (uint64_t)strings.size();
+			info.blocks_size = (uint64_t)blocks.size();
+
+			data.clear();
+			data.reserve(sizeof(info) + offsets.size() * sizeof(uint32_t) + strings.size() + entities.size() * sizeof(entity_record) + components.size() * sizeof(component_record) + blocks.size());
+			write(data, &info, sizeof(info));
+			write(data, offsets.data(), offsets.size() * sizeof(uint32_t));
+			write(data, strings.data(), strings.size());
+			write(data, entities.data(), entities.size() * sizeof(entity_record));
+			write(data, components.data(), components.size() * sizeof(component_record));
+			write(data, blocks.data(), blocks.size());
+			VI_TRACE("[scene] capture snapshot of %" PRIu64 " entities and %" PRIu64 " components (%" PRIu64 " bytes)", (uint64_t)info.entities, (uint64_t)info.components, (uint64_t)data.size());
+		}
+		bool scene_snapshot::restore(scene_graph* scene, core::vector<entity*>* entities) const
+		{
+			VI_ASSERT(scene != nullptr, "scene should be set");
+			VI_MEASURE(core::timings::intensive);
+			VI_PROFILE("scene_snapshot::restore");
+
+			header info;
+			std::string_view input = data;
+			if (!read(input, &info, sizeof(info)) || info.strings == std::numeric_limits<uint32_t>::max())
+				return false;
+
+			core::vector<uint32_t> offsets((size_t)info.strings + 1);
+			core::vector<entity_record> entities(info.entities);
+			core::vector<component_record> components(info.components);
+			if (!read(input, offsets.data(), offsets.size() * sizeof(uint32_t)) || input.size() < info.strings_size)
+				return false;
+
+			std::string_view strings = input.substr(0, (size_t)info.strings_size);
+			input.remove_prefix((size_t)info.strings_size);
+			if (!read(input, entities.data(), entities.size() * sizeof(entity_record)) || !read(input, components.data(), components.size() * sizeof(component_record)) || input.size() < info.blocks_size)
+				return false;
+
+			std::string_view blocks = input.substr(0, (size_t)info.blocks_size);
+			core::vector<entity*> array = scene->add_entities(entities.size());
+			idx_snapshot snapshot;
+			for (size_t i = 0; i < array.size(); i++)
+			{
+				snapshot.to[array[i]] = i;
+				snapshot.from[i] = array[i];
+			}
+
+			scene->snapshot = &snapshot;
+			for (size_t i = 0; i < array.size(); i++)
+			{
+				auto& record = entities[i];
+				entity* next = array[i];
+				if (record.name < info.strings && offsets[record.name] <= offsets[record.name + 1] && offsets[record.name + 1] <= strings.size())
+					next->set_name(strings.substr(offsets[record.name], offsets[record.name + 1] - offsets[record.name]));
+
+				trigonometry::transform* transform = next->get_transform();
+				trigonometry::transform::spacing& space = transform->get_spacing(trigonometry::positioning::global);
+				space.position = trigonometry::vector3(record.position[0], record.position[1], record.position[2]);
+				space.rotation = trigonometry::vector3(record.rotation[0], record.rotation[1], record.rotation[2]);
+				space.scale = trigonometry::vector3(record.scale[0], record.scale[1], record.scale[2]);
+				transform->set_scaling(record.scaling > 0);
+			}
+
+			for (size_t i = 0; i < array.size(); i++)
+			{
+				auto& record = entities[i];
+				entity* next = array[i];
+				if (record.pivot > 0)
+				{
+					trigonometry::transform* root = nullptr;
+					if (record.parent >= 0 && (size_t)record.parent < array.size() && (size_t)record.parent != i)
+						root = array[(size_t)record.parent]->get_transform();
+
+					trigonometry::transform::spacing* space = core::memory::init<trigonometry::transform::spacing>();
+					space->position = trigonometry::vector3(record.pivot_position[0], record.pivot_position[1], record.pivot_position[2]);
+					space->rotation = trigonometry::vector3(record.pivot_rotation[0], record.pivot_rotation[1], record.pivot_rotation[2]);
+					space->scale = trigonometry::vector3(record.pivot_scale[0], record.pivot_scale[1], record.pivot_scale[2]);
+					memcpy(space->offset.row, record.pivot_offset, sizeof(record.pivot_offset));
+
+					trigonometry::transform* offset = next->get_transform();
+					offset->set_pivot(root, space);
+					offset->make_dirty();
+				}
+
+				size_t end = std::min<size_t>((size_t)record.components_offset + record.components_count, components.size());
+				for (size_t j = record.components_offset; j < end; j++)
+				{
+					auto& item = components[j];
+					if (item.offset > blocks.size() || item.size > blocks.size() - item.offset)
+						continue;
+
+					component* target = core::composer::create<component>(item.id, next);
+					if (!target || !next->add_component(target))
+						continue;
+
+					target->set_active(item.active > 0);
+					std::string_view block = blocks.substr((size_t)item.offset, (size_t)item.size);
+					if (item.format == block_format::binary)
+					{
+						target->deserialize_binary(block);
+						continue;
+					}
+
+					core::uptr<core::schema> node = core::var::set::object();
+					if (read_schema(block, *node) && !node->get_childs().empty())
+						target->deserialize(node->get_childs().front());
+				}
+			}
+
+			scene->snapshot = nullptr;
+			if (entities != nullptr)
+				entities->insert(entities->end(), array.begin(), array.end());
+
+			VI_TRACE("[scene] restore snapshot of %" PRIu64 " entities and %" PRIu64 " components", (uint64_t)info.entities, (uint64_t)info.components);
+			return true;
+		}
+		bool scene_snapshot::load(const std::string_view& new_data)
+		{
+			header info;
+			std::string_view input = new_data;
+			if (!read(input, &info, sizeof(info)) || memcmp(info.magic, "VISS", sizeof(info.magic)) != 0 || info.version != 1)
+				return false;
+
+			if (info.strings == std::numeric_limits<uint32_t>::max() || info.strings_size > (uint64_t)new_data.size() || info.blocks_size > (uint64_t)new_data.size())
+				return false;
+
+			uint64_t size = sizeof(info) + ((uint64_t)info.strings + 1) * sizeof(uint32_t) + info.strings_size + (uint64_t)info.entities * sizeof(entity_record) + (uint64_t)info.components * sizeof(component_record) + info.blocks_size;
+			if (size != (uint64_t)new_data.size())
+				return false;
+
+			data = new_data;
+			return true;
+		}
+		const core::string& scene_snapshot::get_data() const
+		{
+			return data;
+		}
+		size_t scene_snapshot::get_entities_count() const
+		{
+			header info;
+			std::string_view input = data;
+			return read(input, &info, sizeof(info)) ? (size_t)info.entities : 0;
+		}
+		void scene_snapshot::write(core::string& output, const void* buffer, size_t size)
+		{
+			output.append((const char*)buffer, size);
+		}
+		bool scene_snapshot::read(std::string_view& input, void* buffer, size_t size)
+		{
+			if (input.size() < size)
+				return false;
+
+			memcpy(buffer, input.data(), size);
+			input.remove_prefix(size);
+			return true;
+		}
+		void scene_snapshot::write_schema(core::string& output, core::schema* node)
+		{
+			core::var_type type = node->value.get_type();
+			uint32_t size = (uint32_t)node->key.size();
+			uint8_t tag = (uint8_t)type;
+			switch (type)
+			{
+				case core::var_type::decimal:
+				case core::var_type::binary:
+					tag = (uint8_t)core::var_type::string;
+					break;
+				case core::var_type::pointer:
+					tag = (uint8_t)core::var_type::null;
+					break;
+				default:
+					break;
+			}
+
+			write(output, &tag, sizeof(tag));
+			write(output, &size, sizeof(size));
+			write(output, node->key.data(), node->key.size());
+			switch ((core::var_type)tag)
+			{
+				case core::var_type::object:
+				case core::var_type::array:
+				{
+					auto& childs = node->get_childs();
+					uint32_t count = (uint32_t)childs.size();
+					write(output, &count, sizeof(count));
+					for (auto* child : childs)
+						write_schema(output, child);
+					break;
+				}
+				case core::var_type::string:
+				{
+					core::string blob = node->value.get_blob();
+					uint32_t length = (uint32_t)blob.size();
+					write(output, &length, sizeof(length));
+					write(output, blob.data(), blob.size());
+					break;
+				}
+				case core::var_type::integer:
+				{
+					int64_t value = node->value.get_integer();
+					write(output, &value, sizeof(value));
+					break;
+				}
+				case core::var_type::number:
+				{
+					double value = node->value.get_number();
+					write(output, &value, sizeof(value));
+					break;
+				}
+				case core::var_type::boolean:
+				{
+					uint8_t value = node->value.get_boolean() ? 1 : 0;
+					write(output, &value, sizeof(value));
+					break;
+				}
+				default:
+					break;
+			}
+		}
+		bool scene_snapshot::read_schema(std::string_view& input, core::schema* parent)
+		{
+			uint8_t tag; uint32_t size;
+			if (!read(input, &tag, sizeof(tag)) || !read(input, &size, sizeof(size)) || input.size() < size)
+				return false;
+
+			core::string key(input.substr(0, size));
+			input.remove_prefix(size);
+
+			bool is_array = parent->value.get_type() == core::var_type::array;
+			switch ((core::var_type)tag)
+			{
+				case core::var_type::object:
+				case core::var_type::array:
+				{
+					uint32_t count;
+					if (!read(input, &count, sizeof(count)))
+						return false;
+
+					core::schema* node = (core::var_type)tag == core::var_type::array ? core::var::set::array() : core::var::set::object();
+					node = is_array ? parent->push(node) : parent->set(key, node);
+					for (uint32_t i = 0; i < count; i++)
+					{
+						if (!read_schema(input, node))
+							return false;
+					}
+					return true;
+				}
+				case core::var_type::string:
+				{
+					uint32_t length;
+					if (!read(input, &length, sizeof(length)) || input.size() < length)
+						return false;
+
+					auto value = core::var::string(input.substr(0, length));
+					input.remove_prefix(length);
+					if (is_array)
+						parent->push(std::move(value));
+					else
+						parent->set(key, std::move(value));
+					return true;
+				}
+				case core::var_type::integer:
+				{
+					int64_t value;
+					if (!read(input, &value, sizeof(value)))
+						return false;
+
+					if (is_array)
+						parent->push(core::var::integer(value));
+					else
+						parent->set(key, core::var::integer(value));
+					return true;
+				}
+				case core::var_type::number:
+				{
+					double value;
+					if (!read(input, &value, sizeof(value)))
+						return false;
+
+					if (is_array)
+						parent->push(core::var::number(value));
+					else
+						parent->set(key, core::var::number(value));
+					return true;
+				}
+				case core::var_type::boolean:
+				{
+					uint8_t value;
+					if (!read(input, &value, sizeof(value)))
+						return false;
+
+					if (is_array)
+						parent->push(core::var::boolean(value > 0));
+					else
+						parent->set(key, core::var::boolean(value > 0));
+					return true;
+				}
+				case core::var_type::undefined:
+				{
+					if (is_array)
+						parent->push(core::var::undefined());
+					else
+						parent->set(key, core::var::undefined());
+					return true;
+				}
+				default:
+				{
+					if (is_array)
+						parent->push(core::var::null());
+					else
+						parent->set(key, core::var::null());
+					return true;
+				}
+			}
+		}
+
+		world_partition::world_partition(scene_graph* new_scene) noexcept : scene(new_scene), memory_budget(0), memory_usage(0), max_loads(2), load_distance(100.0f), unload_distance(150.0f)
+		{
+			VI_ASSERT(scene != nullptr, "scene should be set");
+		}
+		world_partition::~world_partition() noexcept
+		{
+			evict_all();
+			for (auto& next : ready)
+				core::memory::release(next.snapshot);
+			ready.clear();
+		}
+		size_t world_partition::add_cell(const std::string_view& path, const trigonometry::vector3& min, const trigonometry::vector3& max)
+		{
+			cell next;
+			next.path = path;
+			next.min = min;
+			next.max = max;
+			cells.emplace_back(std::move(next));
+			return cells.size() - 1;
+		}
+		void world_partition::update(const viewer& view)
+		{
+			VI_MEASURE(core::timings::pass);
+			VI_PROFILE("world_partition::update");
+			for (auto& next : cells)
+			{
+				trigonometry::vector3 nearest(std::clamp(view.position.x, next.min.x, next.max.x), std::clamp(view.position.y, next.min.y, next.max.y), std::clamp(view.position.z, next.min.z, next.max.z));
+				next.distance = nearest.distance(view.position);
+			}
+
+			for (size_t i = 0; i < cells.size(); i++)
+			{
+				auto& next = cells[i];
+				if (next.state != cell_state::unloaded && next.distance > unload_distance)
+					evict(i);
+			}
+
+			if (memory_budget > 0 && memory_usage > memory_budget)
+			{
+				core::vector<size_t> order;
+				for (size_t i = 0; i < cells.size(); i++)
+				{
+					if (cells[i].state == cell_state::resident && cells[i].distance > load_distance)
+						order.push_back(i);
+				}
+
+				VI_SORT(order.begin(), order.end(), [this](size_t a, size_t b) { return cells[a].distance > cells[b].distance; });
+				for (size_t i = 0; i < order.size() && memory_usage > memory_budget; i++)
+					evict(order[i]);
+			}
+
+			commit();
+
+			size_t loading = 0;
+			core::vector<size_t> candidates;
+			for (size_t i = 0; i < cells.size(); i++)
+			{
+				auto& next = cells[i];
+				if (next.state == cell_state::loading)
+					++loading;
+				else if (next.state == cell_state::unloaded && next.distance <= load_distance)
+					candidates.push_back(i);
+			}
+
+			if (candidates.empty() || loading >= max_loads || (memory_budget > 0 && memory_usage >= memory_budget))
+				return;
+
+			VI_SORT(candidates.begin(), candidates.end(), [this](size_t a, size_t b) { return cells[a].distance < cells[b].distance; });
+			for (size_t i = 0; i < candidates.size() && loading < max_loads; i++, loading++)
+				load(candidates[i]);
+		}
+		void world_partition::update()
+		{
+			if (scene->get_camera() != nullptr)
+				update(scene->get_camera_viewer());
+		}
+		void world_partition::evict_all()
+		{
+			for (size_t i = 0; i < cells.size(); i++)
+				evict(i);
+		}
+		void world_partition::set_distances(float load, float unload)
+		{
+			load_distance = std::max(0.0f, load);
+			unload_distance = std::max(load_distance, unload);
+		}
+		void world_partition::set_memory_budget(size_t bytes)
+		{
+			memory_budget = bytes;
+		}
+		void world_partition::set_max_loads(size_t count)
+		{
+			max_loads = std::max<size_t>(1, count);
+		}
+		const world_partition::cell& world_partition::get_cell(size_t index) const
+		{
+			VI_ASSERT(index < cells.size(), "index outside of range");
+			return cells[index];
+		}
+		size_t world_partition::get_cells_count() const
+		{
+			return cells.size();
+		}
+		size_t world_partition::get_resident_count() const
+		{
+			size_t count = 0;
+			for (auto& next : cells)
+			{
+				if (next.state == cell_state::resident)
+					++count;
+			}
+
+			return count;
+		}
+		size_t world_partition::get_memory_usage() const
+		{
+			return memory_usage;
+		}
+		size_t world_partition::get_memory_budget() const
+		{
+			return memory_budget;
+		}
+		void world_partition::commit()
+		{
+			core::vector<loaded_cell> queue;
+			{
+				core::umutex<std::mutex> unique(exclusive);
+				queue.swap(ready);
+			}
+
+			for (auto& item : queue)
+			{
+				auto& next = cells[item.index];
+				if (next.state != cell_state::loading || next.generation != item.generation)
+				{
+					core::memory::release(item.snapshot);
+					continue;
+				}
+
+				if (!item.snapshot)
+				{
+					next.state = cell_state::failed;
+					++next.failures;
+					continue;
+				}
+
+				item.snapshot->restore(scene, &next.entities);
+				for (auto* base : next.entities)
+					base->add_ref();
+
+				next.state = cell_state::resident;
+				next.memory = item.snapshot->get_data().size();
+				next.latency = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - next.requested).count();
+				memory_usage += next.memory;
+				++next.loads;
+				core::memory::release(item.snapshot);
+				VI_DEBUG("[scene] stream in cell %s: %" PRIu64 " entities, %" PRIu64 " bytes in %.2f ms", next.path.c_str(), (uint64_t)next.entities.size(), (uint64_t)next.memory, next.latency);
+			}
+		}
+		void world_partition::load(size_t index)
+		{
+			auto& next = cells[index];
+			auto* content = scene->get_conf().shared.content;
+			VI_ASSERT(content != nullptr, "content manager should be set");
+
+			next.state = cell_state::loading;
+			next.requested = std::chrono::high_resolution_clock::now();
+			uint64_t generation = ++next.generation;
+
+			add_ref();
+			content->load_deferred(content->get_processor((uint64_t)typeid(scene_snapshot).hash_code()), next.path, core::variant_args()).when([this, index, generation](expects_content<void*>&& result)
+			{
+				result.report("world cell streaming error");
+				{
+					core::umutex<std::mutex> unique(exclusive);
+					ready.push_back({ result ? (scene_snapshot*)*result : nullptr, index, generation });
+				}
+				release();
+			});
+		}
+		void world_partition::evict(size_t index)
+		{
+			auto& next = cells[index];
+			if (next.state == cell_state::unloaded)
+				return;
+
+			++next.generation;
+			if (next.state == cell_state::loading || next.state == cell_state::failed)
+			{
+				next.state = cell_state::unloaded;
+				return;
+			}
+
+			for (auto* base : next.entities)
+			{
+				if (base->is_active())
+					scene->delete_entity(base);
+				base->release();
+			}
+
+			VI_DEBUG("[scene] stream out cell %s: %" PRIu64 " entities, %" PRIu64 " bytes", next.path.c_str(), (uint64_t)next.entities.size(), (uint64_t)next.memory);
+			memory_usage -= std::min(memory_usage, next.memory);
+			next.entities.clear();
+			next.memory = 0;
+			next.state = cell_state::unloaded;
+			++next.evictions;
+		}
+
+		session_recorder::session_recorder() noexcept : seed(0), frames(0), recording(false)
+		{
+		}
+		void session_recorder::begin(uint64_t new_seed)
+		{
+			VI_TRACE("[scene] begin session recording with seed %" PRIu64, new_seed);
+			uint32_t version = 1;
+			data.clear();
+			seed = new_seed;
+			frames = 0;
+			recording = true;
+			write("VIRC", 4);
+			write(&version, sizeof(version));
+			write(&seed, sizeof(seed));
+		}
+		void session_recorder::end()
+		{
+			VI_TRACE("[scene] end session recording with %" PRIu64 " frames", (uint64_t)frames);
+			recording = false;
+		}
+		void session_recorder::record_frame(float delta_time)
+		{
+			record_type type = record_type::frame;
+			write(&type, sizeof(type));
+			write(&delta_time, sizeof(delta_time));
+			++frames;
+		}
+		void session_recorder::record_key_state(graphics::key_code key, graphics::key_mod mod, int computed, int repeat, bool pressed)
+		{
+			record_type type = record_type::key_state;
+			int32_t values[4] = { (int32_t)key, (int32_t)mod, (int32_t)computed, (int32_t)repeat };
+			uint8_t state = pressed ? 1 : 0;
+			write(&type, sizeof(type));
+			write(values, sizeof(values));
+			write(&state, sizeof(state));
+		}
+		void session_recorder::record_input(const char* buffer, size_t length)
+		{
+			record_type type = record_type::input;
+			uint32_t size = (uint32_t)length;
+			write(&type, sizeof(type));
+			write(&size, sizeof(size));
+			write(buffer, length);
+		}
+		void session_recorder::record_cursor_wheel(int x, int y, bool normal, graphics::key_mod mod)
+		{
+			record_type type = record_type::cursor_wheel;
+			int32_t values[3] = { (int32_t)x, (int32_t)y, (int32_t)mod };
+			uint8_t state = normal ? 1 : 0;
+			write(&type, sizeof(type));
+			write(values, sizeof(values));
+			write(&state, sizeof(state));
+		}
+		void session_recorder::record_window_state(graphics::window_state new_state, int x, int y)
+		{
+			record_type type = record_type::window_state;
+			int32_t values[3] = { (int32_t)new_state, (int32_t)x, (int32_t)y };
+			write(&type, sizeof(type));
+			write(values, sizeof(values));
+		}
+		bool session_recorder::load(const std::string_view& new_data)
+		{
+			const size_t header = 4 + sizeof(uint32_t) + sizeof(uint64_t);
+			if (new_data.size() < header || memcmp(new_data.data(), "VIRC", 4) != 0)
+				return false;
+
+			uint32_t version = 0;
+			memcpy(&version, new_data.data() + 4, sizeof(version));
+			if (version != 1)
+				return false;
+
+			data = new_data;
+			memcpy(&seed, data.data() + 4 + sizeof(version), sizeof(seed));
+			frames = 0;
+			recording = false;
+
+			size_t offset = header;
+			while (offset < data.size())
+			{
+				record_type type = (record_type)data[offset++];
+				switch (type)
+				{
+					case record_type::frame:
+						offset += sizeof(float);
+						++frames;
+						break;
+					case record_type::key_state:
+						offset += sizeof(int32_t) * 4 + 1;
+						break;
+					case record_type::input:
+					{
+						uint32_t size = 0;
+						if (offset + sizeof(size) > data.size())
+							return false;
+						memcpy(&size, data.data() + offset, sizeof(size));
+						offset += sizeof(size) + size;
+						break;
+					}
+					case record_type::cursor_wheel:
+						offset += sizeof(int32_t) * 3 + 1;
+						break;
+					case record_type::window_state:
+						offset += sizeof(int32_t) * 3;
+						break;
+					default:
+						return false;
+				}
+			}
+
+			return offset == data.size();
+		}
+		session_recorder::replay_report session_recorder::replay(heavy_application* app, float fixed_step, bool render) const
+		{
+			VI_ASSERT(app != nullptr, "app should be set");
+			VI_ASSERT(fixed_step > 0.0f, "fixed step should be greater than zero");
+			VI_ASSERT(!recording, "recording should be finished");
+			VI_TRACE("[scene] replay session of %" PRIu64 " frames with seed %" PRIu64, (uint64_t)frames, seed);
+
+			replay_report report;
+			core::vector<double> samples[(size_t)scene_step::count + 1];
+			for (auto& next : samples)
+				next.reserve(frames);
+
+			core::uptr<core::timer> clock = new core::timer();
+			clock->set_fixed_frames(1.0f / fixed_step);
+			std::srand((uint32_t)seed);
+
+			auto begin = std::chrono::high_resolution_clock::now();
+			size_t offset = 4 + sizeof(uint32_t) + sizeof(uint64_t);
+			while (offset < data.size())
+			{
+				record_type type = (record_type)data[offset++];
+				const char* buffer = data.data() + offset;
+				gui::context* UI = app->try_get_ui();
+				switch (type)
+				{
+					case record_type::frame:
+					{
+						auto timing = std::chrono::high_resolution_clock::now();
+						clock->begin();
+						app->dispatch(clock.get());
+						clock->finish();
+						if (render)
+							app->publish(clock.get());
+
+						samples[(size_t)scene_step::count].push_back(measure_step(timing));
+						if (app->scene != nullptr)
+						{
+							for (size_t i = 0; i < (size_t)scene_step::count; i++)
+								samples[i].push_back(app->scene->statistics.steps[i]);
+						}
+
+						offset += sizeof(float);
+						++report.frames;
+						break;
+					}
+					case record_type::key_state:
+					{
+						int32_t values[4]; uint8_t state;
+						memcpy(values, buffer, sizeof(values));
+						memcpy(&state, buffer + sizeof(values), sizeof(state));
+						if (UI != nullptr)
+							UI->emit_key((graphics::key_code)values[0], (graphics::key_mod)values[1], values[2], values[3], state > 0);
+						app->key_event((graphics::key_code)values[0], (graphics::key_mod)values[1], values[2], values[3], state > 0);
+						offset += sizeof(values) + sizeof(state);
+						++report.events;
+						break;
+					}
+					case record_type::input:
+					{
+						uint32_t size = 0;
+						memcpy(&size, buffer, sizeof(size));
+						core::string text(buffer + sizeof(size), size);
+						if (UI != nullptr)
+							UI->emit_input(text.c_str(), (int)text.size());
+						app->input_event((char*)text.c_str(), text.size());
+						offset += sizeof(size) + size;
+						++report.events;
+						break;
+					}
+					case record_type::cursor_wheel:
+					{
+						int32_t values[3]; uint8_t state;
+						memcpy(values, buffer, sizeof(values));
+						memcpy(&state, buffer + sizeof(values), sizeof(state));
+						if (UI != nullptr)
+							UI->emit_wheel(values[0], values[1], state > 0, (graphics::key_mod)values[2]);
+						app->wheel_event(values[0], values[1], state > 0);
+						offset += sizeof(values) + sizeof(state);
+						++report.events;
+						break;
+					}
+					case record_type::window_state:
+					{
+						int32_t values[3];
+						memcpy(values, buffer, sizeof(values));
+						if (UI != nullptr && (graphics::window_state)values[0] == graphics::window_state::resize)
+							UI->emit_resize(values[1], values[2]);
+						app->window_event((graphics::window_state)values[0], values[1], values[2]);
+						offset += sizeof(values);
+						++report.events;
+						break;
+					}
+					default:
+						offset = data.size();
+						break;
+				}
+			}
+
+			report.elapsed = measure_step(begin);
+			report.frame = compute_percentiles(samples[(size_t)scene_step::count]);
+			for (size_t i = 0; i < (size_t)scene_step::count; i++)
+				report.steps[i] = compute_percentiles(samples[i]);
+
+			return report;
+		}
+		const core::string& session_recorder::get_data() const
+		{
+			return data;
+		}
+		uint64_t session_recorder::get_seed() const
+		{
+			return seed;
+		}
+		size_t session_recorder::get_frames() const
+		{
+			return frames;
+		}
+		bool session_recorder::is_recording() const
+		{
+			return recording;
+		}
+		void session_recorder::write(const void* buffer, size_t size)
+		{
+			data.append((const char*)buffer, size);
+		}
+		session_recorder::percentiles session_recorder::compute_percentiles(core::vector<double>& samples)
+		{
+			percentiles result;
+			if (samples.empty())
+				return result;
+
+			VI_SORT(samples.begin(), samples.end(), [](double a, double b) { return a < b; });
+			auto at = [&samples](double rank) { return samples[(size_t)(rank * (double)(samples.size() - 1) + 0.5)]; };
+			result.p50 = at(0.50);
+			result.p90 = at(0.90);
+			result.p99 = at(0.99);
+			result.max = samples.back();
+			return result;
+		}
+
 		heavy_application::heavy_application(desc* i) noexcept : control(i ? *i : desc())
 		{
 			VI_ASSERT(i != nullptr, "desc should be set");
@@ -4917,6 +6571,7 @@ namespace vitex
 			if (layer::gui::subsystem::has_instance())
 				layer::gui::subsystem::get()->cleanup_shared();
 
+			core::memory::release(recorder);
 			core::memory::release(scene);
 			core::memory::release(vm);
 			core::memory::release(audio);
@@ -4979,6 +6634,9 @@ namespace vitex
 					{
 						bool render_frame = activity->dispatch(0, control.blocking_dispatch);
 						internal_clock->begin();
+						frame_profiler::get()->next_frame();
+						if (recorder != nullptr && recorder->is_recording())
+							recorder->record_frame((float)internal_clock->get_step());
 						dispatch(internal_clock);
 
 						internal_clock->finish();
@@ -4991,6 +6649,9 @@ namespace vitex
 					while (state == application_state::active)
 					{
 						internal_clock->begin();
+						frame_profiler::get()->next_frame();
+						if (recorder != nullptr && recorder->is_recording())
+							recorder->record_frame((float)internal_clock->get_step());
 						dispatch(internal_clock);
 
 						internal_clock->finish();
@@ -5011,6 +6672,9 @@ namespace vitex
 						queue->dispatch();
 
 						internal_clock->begin();
+						frame_profiler::get()->next_frame();
+						if (recorder != nullptr && recorder->is_recording())
+							recorder->record_frame((float)internal_clock->get_step());
 						dispatch(internal_clock);
 
 						internal_clock->finish();
@@ -5025,6 +6689,9 @@ namespace vitex
 						queue->dispatch();
 
 						internal_clock->begin();
+						frame_profiler::get()->next_frame();
+						if (recorder != nullptr && recorder->is_recording())
+							recorder->record_frame((float)internal_clock->get_step());
 						dispatch(internal_clock);
 
 						internal_clock->finish();
@@ -5053,6 +6720,7 @@ namespace vitex
 				content->add_processor<processors::skin_model_processor, skin_model>();
 				content->add_processor<processors::skin_animation_processor, layer::skin_animation>();
 				content->add_processor<processors::schema_processor, core::schema>();
+				content->add_processor<processors::scene_snapshot_processor, layer::scene_snapshot>();
 				content->add_processor<processors::server_processor, network::http::server>();
 				content->add_processor<processors::hull_shape_processor, physics::hull_shape>();
 
@@ -5128,6 +6796,9 @@ namespace vitex
 				activity->set_cursor_visibility(control.cursor);
 				activity->callbacks.key_state = [this](graphics::key_code key, graphics::key_mod mod, int computed, int repeat, bool pressed)
 				{
+					if (recorder != nullptr && recorder->is_recording())
+						recorder->record_key_state(key, mod, computed, repeat, pressed);
+
 					gui::context* UI = try_get_ui();
 					if (UI != nullptr)
 						UI->emit_key(key, mod, computed, repeat, pressed);
@@ -5138,6 +6809,9 @@ namespace vitex
 					if (!buffer)
 						return;
 
+					if (recorder != nullptr && recorder->is_recording())
+						recorder->record_input(buffer, length < 0 ? strlen(buffer) : (size_t)length);
+
 					gui::context* UI = try_get_ui();
 					if (UI != nullptr)
 						UI->emit_input(buffer, length);
@@ -5145,6 +6819,9 @@ namespace vitex
 				};
 				activity->callbacks.cursor_wheel_state = [this](int x, int y, bool normal)
 				{
+					if (recorder != nullptr && recorder->is_recording())
+						recorder->record_cursor_wheel(x, y, normal, activity->get_key_mod_state());
+
 					gui::context* UI = try_get_ui();
 					if (UI != nullptr)
 						UI->emit_wheel(x, y, normal, activity->get_key_mod_state());
@@ -5152,6 +6829,9 @@ namespace vitex
 				};
 				activity->callbacks.window_state_change = [this](graphics::window_state new_state, int x, int y)
 				{
+					if (recorder != nullptr && recorder->is_recording())
+						recorder->record_window_state(new_state, x, y);
+
 					if (new_state == graphics::window_state::resize)
 					{
 						gui::context* UI = try_get_ui();
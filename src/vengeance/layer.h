@@ -4,6 +4,7 @@
 #include "graphics.h"
 #include "audio.h"
 #include "physics.h"
+#define VI_PROFILE(...) vitex::layer::frame_profiler::scope vi_profile_scope(__VA_ARGS__)
 
 namespace vitex
 {
@@ -21,6 +22,7 @@ namespace vitex
 		typedef std::function<void(const std::string_view&, core::variant_args&)> message_callback;
 		typedef std::function<bool(class component*, const trigonometry::vector3&)> ray_callback;
 		typedef std::function<bool(graphics::render_target*)> target_callback;
+		typedef std::function<void(core::vector<class entity*>&&)> spawn_callback;
 
 		class heavy_series;
 
@@ -49,11 +51,23 @@ namespace vitex
 			USE_GRAPHICS = 1 << 3,
 			USE_ACTIVITY = 1 << 4,
 			USE_AUDIO = 1 << 5,
+			SLAB_ALIGNMENT = 16,
+			SLAB_CLASSES = 128,
+			SLAB_PAGE_ELEMENTS = 256,
+			PROFILER_ZONES = 8192,
 			MAX_STACK_DEPTH = 4,
 			THRESHOLD_PER_ELEMENT = 48,
 			THRESHOLD_PER_THREAD = 1
 		};
 
+		enum class cell_state
+		{
+			unloaded,
+			loading,
+			resident,
+			failed
+		};
+
 		enum class render_opt
 		{
 			none = 0,
@@ -133,6 +147,29 @@ namespace vitex
 			count
 		};
 
+		enum class scene_step
+		{
+			events,
+			transactions,
+			gameplay,
+			simulate,
+			animate,
+			synchronize,
+			indexing,
+			finalize,
+			publish,
+			count
+		};
+
+		enum class animation_tier
+		{
+			full,
+			reduced,
+			minimal,
+			frozen,
+			count
+		};
+
 		enum class composer_tag
 		{
 			component,
@@ -214,6 +251,8 @@ namespace vitex
 			float duration = -1.0f;
 			float rate = 1.0f;
 			float time = 0.0f;
+			size_t span = 0;
+			size_t phase = 0;
 			int64_t frame = -1;
 			int64_t clip = -1;
 
@@ -224,6 +263,18 @@ namespace vitex
 			bool is_playing() const;
 		};
 
+		struct animation_policy
+		{
+			float distances[(size_t)animation_tier::frozen] = { 30.0f, 80.0f, 200.0f };
+			size_t intervals[(size_t)animation_tier::frozen] = { 1, 2, 4 };
+			bool freeze_invisible = true;
+			bool enabled = false;
+
+			animation_tier get_tier(float distance, float radius, bool visible) const;
+			size_t get_interval(animation_tier tier) const;
+			bool is_ticking(animation_tier tier, size_t frame, size_t seed) const;
+		};
+
 		struct spawner_properties
 		{
 			trigonometry::random_vector4 diffusion;
@@ -291,9 +342,9 @@ namespace vitex
 
 		struct animation_buffer
 		{
-			trigonometry::matrix4x4 offsets[graphics::joints_size];
-			trigonometry::vector3 padding;
+			float offset = 0.0f;
 			float animated = 0.0f;
+			trigonometry::vector2 padding;
 		};
 
 		struct render_buffer
@@ -309,6 +360,12 @@ namespace vitex
 				float material_id = 0.0f;
 			};
 
+			struct skin_instance : instance
+			{
+				float offset = 0.0f;
+				float animated = 0.0f;
+			};
+
 			trigonometry::matrix4x4 transform;
 			trigonometry::matrix4x4 world;
 			trigonometry::vector4 texcoord;
@@ -347,6 +404,7 @@ namespace vitex
 		struct pose_matrices
 		{
 			trigonometry::matrix4x4 data[graphics::joints_size];
+			uint32_t palette = 0;
 		};
 
 		struct pose_buffer
@@ -423,8 +481,17 @@ namespace vitex
 
 		class model final : public core::reference<model>
 		{
+		public:
+			struct level
+			{
+				core::vector<graphics::mesh_buffer*> meshes;
+				float size = 0.0f;
+				float error = 0.0f;
+			};
+
 		public:
 			core::vector<graphics::mesh_buffer*> meshes;
+			core::vector<level> levels;
 			trigonometry::vector4 max;
 			trigonometry::vector4 min;
 
@@ -433,6 +500,8 @@ namespace vitex
 			~model() noexcept;
 			void cleanup();
 			graphics::mesh_buffer* find_mesh(const std::string_view& name);
+			graphics::mesh_buffer* get_level_mesh(size_t index, size_t level) const;
+			size_t get_level(float size, size_t current, float hysteresis) const;
 		};
 
 		class skin_model final : public core::reference<skin_model>
@@ -462,11 +531,16 @@ namespace vitex
 		{
 		private:
 			core::vector<trigonometry::skin_animator_clip> clips;
+			core::vector<trigonometry::skin_animator_compressed_clip> compressed;
+			std::mutex exclusive;
+			bool restored;
 
 		public:
 			skin_animation(core::vector<trigonometry::skin_animator_clip>&& data) noexcept;
 			~skin_animation() = default;
 			const core::vector<trigonometry::skin_animator_clip>& get_clips();
+			const core::vector<trigonometry::skin_animator_compressed_clip>& get_compressed_clips();
+			size_t get_memory_usage() const;
 			bool is_valid();
 		};
 
@@ -526,6 +600,117 @@ namespace vitex
 			scene_graph* get_scene() const;
 		};
 
+		class slab_allocator final
+		{
+		private:
+			core::vector<void*> pages;
+			void* free_list;
+			size_t element_size;
+			size_t page_elements;
+			std::mutex exclusive;
+
+		public:
+			slab_allocator(size_t new_element_size, size_t new_page_elements = SLAB_PAGE_ELEMENTS) noexcept;
+			~slab_allocator() noexcept;
+			void reserve(size_t count);
+			void* allocate();
+			void deallocate(void* address);
+			size_t get_element_size() const;
+
+		private:
+			void allocate_page(size_t count);
+
+		public:
+			static void* allocate(size_t size);
+			static void deallocate(void* address, size_t size);
+			static slab_allocator* get(size_t size);
+		};
+
+		class frame_profiler final
+		{
+		public:
+			struct zone
+			{
+				const char* name = nullptr;
+				uint64_t tag = 0;
+				uint64_t begin = 0;
+				uint64_t end = 0;
+				uint32_t depth = 0;
+			};
+
+			struct zone_summary
+			{
+				const char* name = nullptr;
+				double total = 0.0;
+				double max = 0.0;
+				size_t calls = 0;
+				uint32_t depth = 0;
+			};
+
+			struct thread_zones
+			{
+				zone zones[PROFILER_ZONES];
+				std::atomic<uint64_t> sequences[PROFILER_ZONES] = { };
+				std::atomic<uint64_t> head = 0;
+				uint32_t thread = 0;
+				uint32_t depth = 0;
+			};
+
+			class scope
+			{
+			private:
+				thread_zones* target;
+				const char* name;
+				uint64_t tag;
+				uint64_t begin;
+
+			public:
+				scope(const char* new_name, uint64_t new_tag = 0) noexcept;
+				scope(const scope&) = delete;
+				scope(scope&&) = delete;
+				~scope() noexcept;
+				scope& operator= (const scope&) = delete;
+				scope& operator= (scope&&) = delete;
+			};
+
+		private:
+			struct
+			{
+				std::chrono::high_resolution_clock::time_point time;
+				uint64_t ticks = 0;
+			} epoch;
+
+			struct
+			{
+				uint64_t begin = 0;
+				uint64_t end = 0;
+			} frame;
+
+		private:
+			core::vector<thread_zones*> threads;
+			std::atomic<bool> enabled;
+			std::mutex exclusive;
+
+		public:
+			frame_profiler() noexcept;
+			~frame_profiler() noexcept;
+			void set_enabled(bool value);
+			void clear();
+			void next_frame();
+			void summarize(core::vector<zone_summary>& output);
+			core::string export_chrome_trace();
+			double get_ticks_per_microsecond() const;
+			bool is_enabled() const;
+
+		private:
+			thread_zones* get_thread_zones();
+			static bool get_zone(thread_zones* base, uint64_t index, zone& output);
+
+		public:
+			static uint64_t get_ticks();
+			static frame_profiler* get();
+		};
+
 		class component : public core::reference<component>
 		{
 			friend core::reference<component>;
@@ -538,12 +723,15 @@ namespace vitex
 
 		private:
 			size_t set;
+			size_t pending;
 			bool indexed;
 			bool active;
 
 		public:
 			virtual void serialize(core::schema* node);
 			virtual void deserialize(core::schema* node);
+			virtual bool serialize_binary(core::string& output);
+			virtual bool deserialize_binary(const std::string_view& input);
 			virtual void activate(component* init);
 			virtual void deactivate();
 			virtual void synchronize(core::timer* time);
@@ -564,6 +752,10 @@ namespace vitex
 			component(entity* ref, actor_set rule) noexcept;
 			virtual ~component() noexcept;
 
+		public:
+			static void* operator new(size_t size);
+			static void operator delete(void* address, size_t size);
+
 		public:
 			VI_COMPONENT_ROOT("base_component");
 		};
@@ -574,6 +766,9 @@ namespace vitex
 			friend scene_graph;
 			friend render_system;
 
+		public:
+			typedef core::vector<std::pair<uint64_t, component*>> component_array;
+
 		private:
 			struct
 			{
@@ -586,7 +781,7 @@ namespace vitex
 
 			struct
 			{
-				core::unordered_map<uint64_t, component*> components;
+				component_array components;
 				core::string name;
 			} type;
 
@@ -621,13 +816,18 @@ namespace vitex
 		private:
 			entity(scene_graph* new_scene) noexcept;
 			~entity() noexcept;
+			component_array::iterator find_component(uint64_t id);
 
 		public:
-			core::unordered_map<uint64_t, component*>::iterator begin()
+			static void* operator new(size_t size);
+			static void operator delete(void* address, size_t size);
+
+		public:
+			component_array::iterator begin()
 			{
 				return type.components.begin();
 			}
-			core::unordered_map<uint64_t, component*>::iterator end()
+			component_array::iterator end()
 			{
 				return type.components.end();
 			}
@@ -651,10 +851,24 @@ namespace vitex
 
 		public:
 			template <typename t>
-			static bool sortout(t* a, t* b)
+			static uint64_t sortkey(t* a, geo_category category)
 			{
-				return a->parent->snapshot.distance - b->parent->snapshot.distance < 0;
+				return get_sort_key(category, get_sort_slot(a), get_sort_geometry(a, 0), a->parent->snapshot.distance);
 			}
+			static uint64_t get_sort_geometry(void* instance);
+			template <typename t>
+			static auto get_sort_geometry(t* a, int) -> decltype(get_sort_geometry((void*)a->get_drawable()))
+			{
+				return get_sort_geometry((void*)a->get_drawable());
+			}
+			template <typename t>
+			static uint64_t get_sort_geometry(t* a, long)
+			{
+				return 0;
+			}
+			static uint64_t get_sort_key(geo_category category, uint64_t slot, uint64_t geometry, float distance);
+			static uint64_t get_sort_slot(drawable* a);
+			static uint64_t get_sort_slot(component* a);
 		};
 
 		class drawable : public component
@@ -765,6 +979,29 @@ namespace vitex
 				core::vector<void*> queue;
 			} indexing;
 
+			struct rs_caster_volume
+			{
+				trigonometry::frustum6p frustum;
+				trigonometry::vector3 position;
+				float radius = 0.0f;
+				render_culling culling = render_culling::depth_cube;
+			};
+
+			struct rs_caster_bins
+			{
+				core::vector<core::vector<void*>> items;
+				bool ready = false;
+			};
+
+			struct rs_casters
+			{
+				core::unordered_map<uint64_t, rs_caster_bins> lists;
+				core::vector<rs_caster_volume> volumes;
+				trigonometry::bounding bounds;
+				size_t current = std::numeric_limits<size_t>::max();
+				size_t cursor = 0;
+			} casters;
+
 			struct rs_state
 			{
 				friend render_system;
@@ -845,6 +1082,10 @@ namespace vitex
 			void set_updated_constant_buffer(render_buffer_type buffer, uint32_t slot, uint32_t type);
 			void update_constant_buffer(render_buffer_type buffer);
 			void clear_materials();
+			void clear_casters();
+			void add_caster_volume(const trigonometry::vector3& position, float radius);
+			void add_caster_volume(const trigonometry::vector3& position, float radius, const trigonometry::matrix4x4& view_projection);
+			void next_caster_volume();
 			void fetch_visibility(component* base, visibility_query& data);
 			size_t render(core::timer* time, render_state stage, render_opt options);
 			bool try_instance(material* next, render_buffer::instance& target);
@@ -870,6 +1111,7 @@ namespace vitex
 
 		private:
 			sparse_index& get_storage_wrapper(uint64_t section);
+			core::vector<void*>& get_casters(uint64_t section);
 			void watch(core::vector<core::promise<void>>&& tasks);
 
 		private:
@@ -1008,6 +1250,25 @@ namespace vitex
 			template <typename t, typename init_function, typename match_function>
 			void parallel_query(init_function&& init_callback, match_function&& element_callback)
 			{
+				if (casters.current < casters.volumes.size())
+				{
+					auto& items = get_casters(t::get_type_id());
+					init_callback(parallel::get_threads());
+					if (items.size() < THRESHOLD_PER_ELEMENT)
+					{
+						for (auto* item : items)
+							element_callback(0, (t*)item);
+					}
+					else
+					{
+						watch(parallel::for_each(items.begin(), items.end(), THRESHOLD_PER_THREAD, [element_callback](void* item)
+						{
+							element_callback(parallel::get_thread_index(), (t*)item);
+						}));
+					}
+					return;
+				}
+
 				auto& storage = get_storage_wrapper(t::get_type_id());
 				switch (view.culling)
 				{
@@ -1150,6 +1411,7 @@ namespace vitex
 				} shared;
 
 				physics::simulator::desc simulator;
+				animation_policy animation;
 				size_t start_materials = 1ll << 8;
 				size_t start_entities = 1ll << 8;
 				size_t start_components = 1ll << 8;
@@ -1195,12 +1457,27 @@ namespace vitex
 				uint32_t object = (uint32_t)-1;
 			} slots;
 
+			struct
+			{
+				core::vector<subsurface> cache;
+				core::vector<size_t> changes;
+				core::vector<size_t> free;
+				size_t top = 0;
+			} surfaces;
+
 			struct
 			{
 				std::atomic<material*> defaults;
 				float progress = 1.0f;
 			} loading;
 
+			struct
+			{
+				std::atomic<size_t> tiers[(size_t)animation_tier::count];
+				viewer view;
+				bool valid = false;
+			} animating;
+
 			struct
 			{
 				core::single_queue<core::promise<void>> queue[(size_t)task_type::count];
@@ -1210,7 +1487,8 @@ namespace vitex
 
 		protected:
 			core::unordered_map<core::string, core::unordered_set<message_callback*>> listeners;
-			core::unordered_map<uint64_t, core::unordered_set<component*>> changes;
+			core::unordered_map<uint64_t, core::vector<component*>> changes;
+			core::vector<core::vector<component*>> thread_changes;
 			core::unordered_map<uint64_t, sparse_index*> registry;
 			core::unordered_map<component*, size_t> incomplete;
 			core::single_queue<core::task_callback> transactions;
@@ -1222,7 +1500,7 @@ namespace vitex
 			physics::simulator* simulator;
 			std::atomic<component*> camera;
 			std::atomic<bool> active;
-			std::mutex exclusive;
+			mutable std::mutex exclusive;
 			desc conf;
 
 		public:
@@ -1232,6 +1510,8 @@ namespace vitex
 				size_t sorting = 0;
 				size_t instances = 0;
 				size_t draw_calls = 0;
+				size_t animators[(size_t)animation_tier::count] = { 0 };
+				double steps[(size_t)scene_step::count] = { 0.0 };
 			} statistics;
 
 		public:
@@ -1277,6 +1557,7 @@ namespace vitex
 			bool push_event(const std::string_view& event_name, core::variant_args&& args, bool propagate);
 			bool push_event(const std::string_view& event_name, core::variant_args&& args, component* target);
 			bool push_event(const std::string_view& event_name, core::variant_args&& args, entity* target);
+			bool tick_animation(entity* target, animator_state& state, core::timer* time);
 			message_callback* set_listener(const std::string_view& event, message_callback&& callback);
 			bool clear_listener(const std::string_view& event, message_callback* id);
 			bool add_material(material* base);
@@ -1295,18 +1576,21 @@ namespace vitex
 			material* get_material(const std::string_view& material);
 			material* get_material(size_t material);
 			sparse_index& get_storage(uint64_t section);
+			const sparse_index* find_storage(uint64_t section) const;
 			core::pool<component*>& get_components(uint64_t section);
 			core::pool<component*>& get_actors(actor_type type);
 			graphics::render_target_2d::desc get_desc_rt() const;
 			graphics::multi_render_target_2d::desc get_desc_mrt() const;
 			graphics::format get_format_mrt(unsigned int target) const;
 			core::vector<entity*> clone_entity_as_array(entity* value);
+			void spawn_entities(entity* prefab, size_t count, spawn_callback&& callback = nullptr);
 			core::vector<entity*> query_by_parent(entity* parent) const;
 			core::vector<entity*> query_by_name(const std::string_view& name) const;
 			core::vector<component*> query_by_position(uint64_t section, const trigonometry::vector3& position, float radius);
 			core::vector<component*> query_by_area(uint64_t section, const trigonometry::vector3& min, const trigonometry::vector3& max);
 			core::vector<component*> query_by_match(uint64_t section, std::function<bool(const trigonometry::bounding&)>&& match_callback);
 			core::vector<std::pair<component*, trigonometry::vector3>> query_by_ray(uint64_t section, const trigonometry::ray& origin);
+			size_t query_by_nearest(uint64_t section, trigonometry::cosmos::nearest_iterator& context, const trigonometry::vector3& position, size_t count, component** results, float* distances = nullptr) const;
 			core::vector<depth_cube_map*>& get_points_mapping();
 			core::vector<depth_map*>& get_spots_mapping();
 			core::vector<depth_cascade_map*>& get_lines_mapping();
@@ -1315,6 +1599,7 @@ namespace vitex
 			entity* add_entity();
 			entity* clone_entity(entity* value);
 			bool add_entity(entity* entity);
+			core::vector<entity*> add_entities(size_t count);
 			bool is_active() const;
 			bool is_left_handed() const;
 			bool is_indexed() const;
@@ -1352,11 +1637,14 @@ namespace vitex
 			bool unload_component(component* base);
 			void register_component(component* base, bool verify);
 			void unregister_component(component* base);
-			void clone_entities(entity* instance, core::vector<entity*>* array);
+			void clone_entities(entity* instance, core::vector<entity*>* array, bool publish = true);
+			void publish_entities(core::vector<entity*>& array);
 			void generate_material_buffer();
 			void generate_depth_buffers();
 			void notify_cosmos(component* base);
 			void clear_cosmos(component* base);
+			void enqueue_cosmos(component* base);
+			void dequeue_cosmos(component* base);
 			void update_cosmos(sparse_index& storage, component* base);
 			void fill_material_buffers();
 			void resize_render_buffers();
@@ -1365,9 +1653,72 @@ namespace vitex
 			bool resolve_event(event& data);
 			void watch_movement(entity* base);
 			void unwatch_movement(entity* base);
-			entity* clone_entity_instance(entity* entity);
+			entity* clone_entity_instance(entity* entity, bool publish = true);
 
 		public:
+			template <typename overlaps_function, typename visitor_function>
+			bool visit_by_match(uint64_t section, trigonometry::cosmos::iterator& context, overlaps_function&& overlaps, visitor_function&& visitor) const
+			{
+				const sparse_index* storage = find_storage(section);
+				return !storage || storage->index.template visit_index<component>(context, std::forward<overlaps_function>(overlaps), std::forward<visitor_function>(visitor));
+			}
+			template <typename visitor_function>
+			bool visit_by_area(uint64_t section, trigonometry::cosmos::iterator& context, const trigonometry::vector3& min, const trigonometry::vector3& max, visitor_function&& visitor) const
+			{
+				trigonometry::bounding target(min, max);
+				return visit_by_match(section, context, [&target](const trigonometry::bounding& bounds) { return target.overlaps(bounds); }, std::forward<visitor_function>(visitor));
+			}
+			template <typename visitor_function>
+			bool visit_by_sphere(uint64_t section, trigonometry::cosmos::iterator& context, const trigonometry::vector3& center, float radius, visitor_function&& visitor) const
+			{
+				return visit_by_match(section, context, [&center, radius](const trigonometry::bounding& bounds) { return bounds.overlaps_sphere(center, radius); }, std::forward<visitor_function>(visitor));
+			}
+			template <typename visitor_function>
+			bool visit_by_capsule(uint64_t section, trigonometry::cosmos::iterator& context, const trigonometry::vector3& start, const trigonometry::vector3& end, float radius, visitor_function&& visitor) const
+			{
+				return visit_by_match(section, context, [&start, &end, radius](const trigonometry::bounding& bounds) { return bounds.overlaps_capsule(start, end, radius); }, std::forward<visitor_function>(visitor));
+			}
+			template <typename visitor_function>
+			bool visit_by_obb(uint64_t section, trigonometry::cosmos::iterator& context, const trigonometry::matrix4x4& world, visitor_function&& visitor) const
+			{
+				return visit_by_match(section, context, [&world](const trigonometry::bounding& bounds) { return bounds.overlaps_obb(world); }, std::forward<visitor_function>(visitor));
+			}
+			template <typename visitor_function>
+			bool visit_by_cone(uint64_t section, trigonometry::cosmos::iterator& context, const trigonometry::vector3& origin, const trigonometry::vector3& direction, float range, float angle, visitor_function&& visitor) const
+			{
+				trigonometry::vector3 axis = direction.snormalize();
+				return visit_by_match(section, context, [&origin, &axis, range, angle](const trigonometry::bounding& bounds) { return bounds.overlaps_cone(origin, axis, range, angle); }, std::forward<visitor_function>(visitor));
+			}
+			template <typename t, typename visitor_function>
+			bool visit_by_area(trigonometry::cosmos::iterator& context, const trigonometry::vector3& min, const trigonometry::vector3& max, visitor_function&& visitor) const
+			{
+				return visit_by_area(t::get_type_id(), context, min, max, std::forward<visitor_function>(visitor));
+			}
+			template <typename t, typename visitor_function>
+			bool visit_by_sphere(trigonometry::cosmos::iterator& context, const trigonometry::vector3& center, float radius, visitor_function&& visitor) const
+			{
+				return visit_by_sphere(t::get_type_id(), context, center, radius, std::forward<visitor_function>(visitor));
+			}
+			template <typename t, typename visitor_function>
+			bool visit_by_capsule(trigonometry::cosmos::iterator& context, const trigonometry::vector3& start, const trigonometry::vector3& end, float radius, visitor_function&& visitor) const
+			{
+				return visit_by_capsule(t::get_type_id(), context, start, end, radius, std::forward<visitor_function>(visitor));
+			}
+			template <typename t, typename visitor_function>
+			bool visit_by_obb(trigonometry::cosmos::iterator& context, const trigonometry::matrix4x4& world, visitor_function&& visitor) const
+			{
+				return visit_by_obb(t::get_type_id(), context, world, std::forward<visitor_function>(visitor));
+			}
+			template <typename t, typename visitor_function>
+			bool visit_by_cone(trigonometry::cosmos::iterator& context, const trigonometry::vector3& origin, const trigonometry::vector3& direction, float range, float angle, visitor_function&& visitor) const
+			{
+				return visit_by_cone(t::get_type_id(), context, origin, direction, range, angle, std::forward<visitor_function>(visitor));
+			}
+			template <typename t>
+			size_t query_by_nearest(trigonometry::cosmos::nearest_iterator& context, const trigonometry::vector3& position, size_t count, component** results, float* distances = nullptr) const
+			{
+				return query_by_nearest(t::get_type_id(), context, position, count, results, distances);
+			}
 			template <typename t, typename match_function>
 			core::vector<component*> query_by_match(match_function&& match_callback)
 			{
@@ -1444,6 +1795,197 @@ namespace vitex
 			graphics::graphics_device* get_device() const;
 		};
 
+		class scene_snapshot final : public core::reference<scene_snapshot>
+		{
+		private:
+			enum class block_format : uint8_t
+			{
+				binary,
+				schema
+			};
+
+			struct header
+			{
+				char magic[4];
+				uint32_t version;
+				uint32_t strings;
+				uint32_t entities;
+				uint32_t components;
+				uint32_t padding;
+				uint64_t strings_size;
+				uint64_t blocks_size;
+			};
+
+			struct entity_record
+			{
+				float position[3];
+				float rotation[3];
+				float scale[3];
+				float pivot_position[3];
+				float pivot_rotation[3];
+				float pivot_scale[3];
+				float pivot_offset[16];
+				int64_t parent;
+				uint32_t name;
+				uint32_t components_offset;
+				uint32_t components_count;
+				uint8_t scaling;
+				uint8_t pivot;
+				uint8_t padding[2];
+			};
+
+			struct component_record
+			{
+				uint64_t id;
+				uint64_t offset;
+				uint64_t size;
+				block_format format;
+				uint8_t active;
+				uint8_t padding[6];
+			};
+
+		private:
+			core::string data;
+
+		public:
+			scene_snapshot() noexcept = default;
+			~scene_snapshot() noexcept = default;
+			void capture(scene_graph* scene);
+			bool restore(scene_graph* scene, core::vector<entity*>* entities = nullptr) const;
+			bool load(const std::string_view& new_data);
+			const core::string& get_data() const;
+			size_t get_entities_count() const;
+
+		public:
+			static void write(core::string& output, const void* buffer, size_t size);
+			static bool read(std::string_view& input, void* buffer, size_t size);
+
+		private:
+			static void write_schema(core::string& output, core::schema* node);
+			static bool read_schema(std::string_view& input, core::schema* parent);
+		};
+
+		class world_partition final : public core::reference<world_partition>
+		{
+		public:
+			struct cell
+			{
+				core::string path;
+				core::vector<entity*> entities;
+				trigonometry::vector3 min;
+				trigonometry::vector3 max;
+				std::chrono::high_resolution_clock::time_point requested;
+				cell_state state = cell_state::unloaded;
+				uint64_t generation = 0;
+				size_t memory = 0;
+				size_t loads = 0;
+				size_t evictions = 0;
+				size_t failures = 0;
+				double latency = 0.0;
+				float distance = 0.0f;
+			};
+
+		private:
+			struct loaded_cell
+			{
+				scene_snapshot* snapshot;
+				size_t index;
+				uint64_t generation;
+			};
+
+		private:
+			core::vector<loaded_cell> ready;
+			core::vector<cell> cells;
+			scene_graph* scene;
+			size_t memory_budget;
+			size_t memory_usage;
+			size_t max_loads;
+			float load_distance;
+			float unload_distance;
+			std::mutex exclusive;
+
+		public:
+			world_partition(scene_graph* new_scene) noexcept;
+			~world_partition() noexcept;
+			size_t add_cell(const std::string_view& path, const trigonometry::vector3& min, const trigonometry::vector3& max);
+			void update(const viewer& view);
+			void update();
+			void evict_all();
+			void set_distances(float load, float unload);
+			void set_memory_budget(size_t bytes);
+			void set_max_loads(size_t count);
+			const cell& get_cell(size_t index) const;
+			size_t get_cells_count() const;
+			size_t get_resident_count() const;
+			size_t get_memory_usage() const;
+			size_t get_memory_budget() const;
+
+		private:
+			void commit();
+			void load(size_t index);
+			void evict(size_t index);
+		};
+
+		class session_recorder final : public core::reference<session_recorder>
+		{
+		public:
+			struct percentiles
+			{
+				double p50 = 0.0;
+				double p90 = 0.0;
+				double p99 = 0.0;
+				double max = 0.0;
+			};
+
+			struct replay_report
+			{
+				percentiles steps[(size_t)scene_step::count];
+				percentiles frame;
+				double elapsed = 0.0;
+				size_t frames = 0;
+				size_t events = 0;
+			};
+
+		private:
+			enum class record_type : uint8_t
+			{
+				frame,
+				key_state,
+				input,
+				cursor_wheel,
+				window_state
+			};
+
+		private:
+			core::string data;
+			uint64_t seed;
+			size_t frames;
+			bool recording;
+
+		public:
+			session_recorder() noexcept;
+			~session_recorder() noexcept = default;
+			void begin(uint64_t new_seed);
+			void end();
+			void record_frame(float delta_time);
+			void record_key_state(graphics::key_code key, graphics::key_mod mod, int computed, int repeat, bool pressed);
+			void record_input(const char* buffer, size_t length);
+			void record_cursor_wheel(int x, int y, bool normal, graphics::key_mod mod);
+			void record_window_state(graphics::window_state new_state, int x, int y);
+			bool load(const std::string_view& new_data);
+			replay_report replay(heavy_application* app, float fixed_step, bool render = true) const;
+			const core::string& get_data() const;
+			uint64_t get_seed() const;
+			size_t get_frames() const;
+			bool is_recording() const;
+
+		private:
+			void write(const void* buffer, size_t size);
+
+		public:
+			static percentiles compute_percentiles(core::vector<double>& samples);
+		};
+
 		class heavy_application : public core::singleton<heavy_application>
 		{
 		public:
@@ -1481,6 +2023,7 @@ namespace vitex
 			heavy_content_manager* content = nullptr;
 			app_data* database = nullptr;
 			scene_graph* scene = nullptr;
+			session_recorder* recorder = nullptr;
 			desc control;
 
 		public:
@@ -1536,21 +2079,29 @@ namespace vitex
 		template <typename geometry, typename instance>
 		struct batching_group
 		{
-			core::vector<instance> instances;
 			graphics::element_buffer* data_buffer = nullptr;
 			geometry* geometry_buffer = nullptr;
 			material* material_data = nullptr;
+			uint32_t instance_location = 0;
+			uint32_t instance_count = 0;
+		};
+
+		struct batching_arena
+		{
+			core::vector<graphics::element_buffer*> retired;
+			graphics::element_buffer* data_buffer = nullptr;
+			size_t offset = 0;
 		};
 
 		template <typename geometry, typename instance>
 		struct batch_dispatchable
 		{
-			size_t name;
+			uint64_t name;
 			geometry* data;
 			material* surface;
 			instance params;
 
-			batch_dispatchable(size_t new_name, geometry* new_data, material* new_surface, const instance& new_params) noexcept : name(new_name), data(new_data), surface(new_surface), params(new_params)
+			batch_dispatchable(uint64_t new_name, geometry* new_data, material* new_surface, const instance& new_params) noexcept : name(new_name), data(new_data), surface(new_surface), params(new_params)
 			{
 			}
 		};
@@ -1566,16 +2117,16 @@ namespace vitex
 			core::single_queue<batch_group*>* cache = nullptr;
 			core::vector<core::vector<dispatchable>>* queue = nullptr;
 			core::vector<dispatchable>* instances = nullptr;
+			core::vector<uint64_t>* keys = nullptr;
+			trigonometry::radix_sorter* sorter = nullptr;
+			batching_arena* arena = nullptr;
 			core::vector<batch_group*> groups;
 
 		public:
 			void clear()
 			{
 				for (auto* group : groups)
-				{
-					group->instances.clear();
 					cache->push(group);
-				}
 
 				queue->clear();
 				groups.clear();
@@ -1586,10 +2137,7 @@ namespace vitex
 					queue->resize(max_size);
 
 				for (auto* group : groups)
-				{
-					group->instances.clear();
 					cache->push(group);
-				}
 				groups.clear();
 			}
 			void emplace(geometry* data, material* surface, const instance& params, size_t chunk)
@@ -1597,22 +2145,30 @@ namespace vitex
 				VI_ASSERT(chunk < queue->size(), "chunk index is out of range");
 				(*queue)[chunk].emplace_back(get_key_id(data, surface), data, surface, params);
 			}
-			size_t compile(graphics::graphics_device* device)
+			size_t compile(graphics::graphics_device* device, bool reset = false)
 			{
 				VI_ASSERT(device != nullptr, "device should be set");
-				populate_instances();
-				populate_groups();
-				compile_groups(device);
+				if (reset)
+					reset_arena();
+
+				uint32_t* indices = populate_instances();
+				if (indices != nullptr)
+					populate_groups(device, indices);
+
+				instances->clear();
 				return groups.size();
 			}
 
 		private:
-			void populate_instances()
+			uint32_t* populate_instances()
 			{
 				size_t total = 0;
 				for (auto& context : *queue)
 					total += context.size();
 
+				if (!total)
+					return nullptr;
+
 				instances->reserve(total);
 				for (auto& context : *queue)
 				{
@@ -1620,55 +2176,80 @@ namespace vitex
 					context.clear();
 				}
 
-				VI_SORT(instances->begin(), instances->end(), [](dispatchable& a, dispatchable& b)
-				{
-					return a.name < b.name;
-				});
+				keys->resize(total);
+				for (size_t i = 0; i < total; i++)
+					(*keys)[i] = (*instances)[i].name;
+
+				return sorter->sort(keys->data(), (uint32_t)total).get_indices();
 			}
-			void populate_groups()
+			void populate_groups(graphics::graphics_device* device, uint32_t* indices)
 			{
-				size_t name = 0;
+				graphics::resource_map mode;
+				size_t total = instances->size();
+				if (!reserve_arena(device, total, &mode))
+					return;
+
+				graphics::mapped_subresource stream;
+				if (!device->map(arena->data_buffer, mode, &stream))
+					return;
+
+				instance* array = (instance*)stream.pointer + arena->offset;
 				batch_group* next = nullptr;
-				for (auto& item : *instances)
+				for (size_t i = 0; i < total; i++)
 				{
-					if (next != nullptr && name == item.name)
+					auto& item = (*instances)[indices[i]];
+					array[i] = item.params;
+					if (next != nullptr && next->geometry_buffer == item.data && next->material_data == item.surface)
 					{
-						next->instances.emplace_back(std::move(item.params));
+						++next->instance_count;
 						continue;
 					}
 
-					name = item.name;
 					next = fetch_group();
+					next->data_buffer = arena->data_buffer;
 					next->geometry_buffer = item.data;
 					next->material_data = item.surface;
-					next->instances.emplace_back(std::move(item.params));
+					next->instance_location = (uint32_t)(arena->offset + i);
+					next->instance_count = 1;
 					groups.push_back(next);
 				}
-				instances->clear();
+
+				device->unmap(arena->data_buffer, &stream);
+				arena->offset += total;
 			}
-			void compile_groups(graphics::graphics_device* device)
+			bool reserve_arena(graphics::graphics_device* device, size_t count, graphics::resource_map* mode)
 			{
-				for (auto* group : groups)
+				size_t capacity = arena->data_buffer ? (size_t)arena->data_buffer->get_elements() : 0;
+				if (arena->offset + count <= capacity)
 				{
-					if (group->data_buffer && group->instances.size() < (size_t)group->data_buffer->get_elements())
-					{
-						device->update_buffer(group->data_buffer, (void*)group->instances.data(), sizeof(instance) * group->instances.size());
-						continue;
-					}
-
-					graphics::element_buffer::desc desc = graphics::element_buffer::desc();
-					desc.access_flags = graphics::cpu_access::write;
-					desc.usage = graphics::resource_usage::dynamic;
-					desc.bind_flags = graphics::resource_bind::vertex_buffer;
-					desc.element_count = (unsigned int)group->instances.size();
-					desc.elements = (void*)group->instances.data();
-					desc.element_width = sizeof(instance);
-
-					core::memory::release(group->data_buffer);
-					group->data_buffer = device->create_element_buffer(desc).or_else(nullptr);
-					if (!group->data_buffer)
-						group->instances.clear();
+					*mode = arena->offset > 0 ? graphics::resource_map::write_no_overwrite : graphics::resource_map::write_discard;
+					return true;
 				}
+
+				if (arena->offset > 0)
+					arena->retired.push_back(arena->data_buffer);
+				else
+					core::memory::release(arena->data_buffer);
+
+				graphics::element_buffer::desc desc = graphics::element_buffer::desc();
+				desc.access_flags = graphics::cpu_access::write;
+				desc.usage = graphics::resource_usage::dynamic;
+				desc.bind_flags = graphics::resource_bind::vertex_buffer;
+				desc.element_count = (unsigned int)std::max<size_t>(std::max<size_t>(count, capacity + capacity / 2), 64);
+				desc.element_width = sizeof(instance);
+
+				arena->offset = 0;
+				arena->data_buffer = device->create_element_buffer(desc).or_else(nullptr);
+				*mode = graphics::resource_map::write_discard;
+				return arena->data_buffer != nullptr;
+			}
+			void reset_arena()
+			{
+				for (auto* next : arena->retired)
+					core::memory::release(next);
+
+				arena->retired.clear();
+				arena->offset = 0;
 			}
 			batch_group* fetch_group()
 			{
@@ -1679,12 +2260,11 @@ namespace vitex
 				cache->pop();
 				return result;
 			}
-			size_t get_key_id(geometry* data, material* surface)
+			uint64_t get_key_id(geometry* data, material* surface)
 			{
 				std::hash<void*> hash;
-				size_t seed = hash((void*)data);
-				seed ^= hash((void*)surface) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-				return seed;
+				uint64_t slot = surface ? (uint64_t)surface->slot + 1 : 0;
+				return ((slot & 0xFFFF) << 48) | ((uint64_t)hash((void*)data) & 0xFFFFFFFFFFFF);
 			}
 		};
 
@@ -1709,9 +2289,19 @@ namespace vitex
 			{
 				core::vector<core::vector<dispatchable>> queue;
 				core::vector<dispatchable> instances;
+				core::vector<uint64_t> keys;
 				core::single_queue<batch_group*> groups;
+				trigonometry::radix_sorter sorter;
+				batching_arena arena;
 			} caching;
 
+			struct
+			{
+				trigonometry::radix_sorter sorter;
+				core::vector<uint64_t> keys;
+				storage swap;
+			} sorting[(size_t)geo_category::count + 1];
+
 		private:
 			batching batchers[max][(size_t)geo_category::count];
 			storage data[max][(size_t)geo_category::count];
@@ -1731,6 +2321,9 @@ namespace vitex
 						auto& next = batchers[j][i];
 						next.queue = &caching.queue;
 						next.instances = &caching.instances;
+						next.keys = &caching.keys;
+						next.sorter = &caching.sorter;
+						next.arena = &caching.arena;
 						next.cache = &caching.groups;
 					}
 				}
@@ -1746,10 +2339,13 @@ namespace vitex
 				while (!caching.groups.empty())
 				{
 					auto* next = caching.groups.front();
-					core::memory::release(next->data_buffer);
 					core::memory::deinit(next);
 					caching.groups.pop();
 				}
+
+				for (auto* next : caching.arena.retired)
+					core::memory::release(next);
+				core::memory::release(caching.arena.data_buffer);
 			}
 			batching& batcher(geo_category category = geo_category::opaque)
 			{
@@ -1797,6 +2393,25 @@ namespace vitex
 					queue.clear();
 			}
 
+			void sort(storage& array, size_t context, geo_category category)
+			{
+				size_t size = array.size();
+				if (size < 2)
+					return;
+
+				VI_PROFILE("renderer_proxy::sort");
+				auto& next = sorting[context];
+				next.keys.resize(size);
+				for (size_t i = 0; i < size; i++)
+					next.keys[i] = entity::sortkey<t>(array[i], category);
+
+				uint32_t* indices = next.sorter.sort(next.keys.data(), (uint32_t)size).get_indices();
+				next.swap.resize(size);
+				for (size_t i = 0; i < size; i++)
+					next.swap[i] = array[indices[i]];
+				array.swap(next.swap);
+			}
+
 		private:
 			template <typename push_function>
 			void dispatch(push_function&& callback)
@@ -1808,6 +2423,7 @@ namespace vitex
 			typename std::enable_if<std::is_base_of<drawable, q>::value>::type cullout(render_system* system, storage* top, bool assume_sorted)
 			{
 				VI_MEASURE(core::timings::frame);
+				VI_PROFILE("renderer_proxy::cull");
 				if (assume_sorted)
 				{
 					auto* scene = system->get_scene();
@@ -1851,16 +2467,16 @@ namespace vitex
 					{
 						auto& array = top[i];
 						scene->statistics.instances += array.size();
-						scene->watch(task_type::rendering, parallel::enqueue([&array]()
+						scene->watch(task_type::rendering, parallel::enqueue([this, &array, i]()
 						{
-							VI_SORT(array.begin(), array.end(), entity::sortout<t>);
+							sort(array, i, (geo_category)i);
 						}));
 					}
 
 					scene->statistics.instances += culling.size();
 					scene->watch(task_type::rendering, parallel::enqueue([this]()
 					{
-						VI_SORT(culling.begin(), culling.end(), entity::sortout<t>);
+						sort(culling, (size_t)geo_category::count, geo_category::count);
 					}));
 					scene->await(task_type::rendering);
 				}
@@ -1875,6 +2491,7 @@ namespace vitex
 			typename std::enable_if<!std::is_base_of<drawable, q>::value>::type cullout(render_system* system, storage* top, bool assume_sorted)
 			{
 				VI_MEASURE(core::timings::frame);
+				VI_PROFILE("renderer_proxy::cull");
 				auto& subframe = top[(size_t)geo_category::opaque];
 				if (assume_sorted)
 				{
@@ -1906,12 +2523,13 @@ namespace vitex
 				++scene->statistics.sorting;
 				scene->statistics.instances += subframe.size();
 				if (!has_batching())
-					VI_SORT(subframe.begin(), subframe.end(), entity::sortout<t>);
+					sort(subframe, (size_t)geo_category::opaque, geo_category::opaque);
 			}
 			template <class q = t>
 			typename std::enable_if<std::is_base_of<drawable, q>::value>::type subcull(render_system* system, storage* top)
 			{
 				VI_MEASURE(core::timings::frame);
+				VI_PROFILE("renderer_proxy::subcull");
 				for (size_t i = 0; i < (size_t)geo_category::count; ++i)
 					top[i].clear();
 
@@ -1941,9 +2559,9 @@ namespace vitex
 					{
 						auto& array = top[i];
 						scene->statistics.instances += array.size();
-						scene->watch(task_type::rendering, parallel::enqueue([&array]()
+						scene->watch(task_type::rendering, parallel::enqueue([this, &array, i]()
 						{
-							VI_SORT(array.begin(), array.end(), entity::sortout<t>);
+							sort(array, i, (geo_category)i);
 						}));
 					}
 					scene->await(task_type::rendering);
@@ -1982,7 +2600,7 @@ namespace vitex
 				++scene->statistics.sorting;
 				scene->statistics.instances += subframe.size();
 				if (!has_batching())
-					VI_SORT(subframe.begin(), subframe.end(), entity::sortout<t>);
+					sort(subframe, (size_t)geo_category::opaque, geo_category::opaque);
 			}
 		};
 
@@ -2085,6 +2703,7 @@ namespace vitex
 				if (!proceed || !proxy.has_batching())
 					return;
 
+				VI_PROFILE("renderer_proxy::batch");
 				graphics::graphics_device* device = system->get_device();
 				for (size_t i = 0; i < (size_t)geo_category::count; ++i)
 				{
@@ -2099,7 +2718,7 @@ namespace vitex
 					}));
 
 					auto* scene = system->get_scene();
-					scene->statistics.batching += batcher.compile(device);
+					scene->statistics.batching += batcher.compile(device, i == 0 && !system->state.is_subpass());
 				}
 			}
 			void end_pass() override
@@ -2123,6 +2742,7 @@ namespace vitex
 					category = geo_category::additive;
 
 				VI_MEASURE(core::timings::frame);
+				VI_PROFILE("renderer_proxy::subcull");
 				if (proxy.has_batching())
 				{
 					auto& frame = proxy.batches(category);
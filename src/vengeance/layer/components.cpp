@@ -1291,6 +1291,7 @@ namespace vitex
 			{
 				core::memory::release(instance);
 				instance = drawable;
+				level = 0;
 				clear_materials();
 
 				if (!instance)
@@ -1676,47 +1677,68 @@ namespace vitex
 				if (!animation || state.paused)
 					return;
 
-				auto& clips = animation->get_clips();
+				bool ticking = parent->get_scene()->tick_animation(parent, state, time);
+				auto& clips = animation->get_compressed_clips();
 				if (!state.blended)
 				{
-					if (state.clip < 0 || state.clip >= (int64_t)clips.size() || state.frame < 0 || state.frame >= (int64_t)clips[(size_t)state.clip].keys.size())
+					if (state.clip < 0 || state.clip >= (int64_t)clips.size() || state.frame < 0 || state.frame >= (int64_t)clips[(size_t)state.clip].get_frames_count())
+						return;
+
+					if (!ticking)
+					{
+						if (state.phase < state.span)
+							apply_pose((float)++state.phase / (float)state.span);
 						return;
+					}
 
 					auto& clip = clips[(size_t)state.clip];
-					auto& next_key = clip.keys[(size_t)state.frame + 1 >= clip.keys.size() ? 0 : (size_t)state.frame + 1];
-					auto& prev_key = clip.keys[(size_t)state.frame];
+					size_t frames = clip.get_frames_count();
 					state.duration = clip.duration;
 					state.rate = clip.rate;
-					state.time = state.get_timeline(time);
+					state.time += state.rate * (float)time->get_step() * (float)state.span;
 
-					float t = state.get_progress();
-					for (auto&& pose : instance->skeleton.offsets)
+					bool finished = false;
+					for (size_t i = 0; i < frames && state.get_progress_total() >= 1.0f; i++)
 					{
-						auto& prev = prev_key.pose[pose.first];
-						auto& next = next_key.pose[pose.first];
-						pose.second.frame.position = prev.position.lerp(next.position, t);
-						pose.second.frame.scale = prev.scale.lerp(next.scale, t);
-						pose.second.frame.rotation = prev.rotation.slerp(next.rotation, t);
-						pose.second.offset = pose.second.frame;
+						if (state.frame + 1 >= (int64_t)frames && !state.looped)
+						{
+							finished = true;
+							break;
+						}
+
+						state.time -= state.get_seconds_duration();
+						state.frame = state.frame + 1 >= (int64_t)frames ? 0 : state.frame + 1;
 					}
 
 					if (state.get_progress_total() >= 1.0f)
-					{
-						if (state.frame + 1 >= (int64_t)clip.keys.size())
-						{
-							if (!state.looped)
-								blend_animation(-1, -1);
-							state.frame = -1;
-						}
+						state.time = state.get_seconds_duration();
 
-						state.time = 0.0f;
-						if (state.looped || state.frame != -1)
-							state.frame++;
+					sample_pose(clip, (size_t)state.frame, state.get_progress());
+					from.resize(pose.size());
+					for (auto&& offset : instance->skeleton.offsets)
+					{
+						if (offset.first < from.size())
+							from[offset.first] = offset.second.offset;
 					}
+
+					state.phase = finished ? state.span : 1;
+					apply_pose((float)state.phase / (float)state.span);
+					if (finished)
+						blend_animation(-1, -1);
 				}
+				else if (!ticking)
+					return;
 				else if (state.get_progress_total() < 1.0f)
 				{
-					auto* keys = (is_exists(state.clip, state.frame) ? get_frame(state.clip, state.frame) : nullptr);
+					const trigonometry::skin_animator_key* keys = nullptr;
+					if (is_exists(state.clip, state.frame))
+					{
+						auto& target = animation->get_compressed_clips()[(size_t)state.clip];
+						key.time = target.timeline[(size_t)state.frame];
+						target.sample_frame((size_t)state.frame, key.pose);
+						keys = &key;
+					}
+
 					state.time = state.get_timeline(time);
 					float t = state.get_progress();
 
@@ -1741,6 +1763,43 @@ namespace vitex
 				{
 					state.blended = false;
 					state.time = 0.0f;
+					state.span = 0;
+				}
+			}
+			void skin_animator::sample_pose(const trigonometry::skin_animator_compressed_clip& clip, size_t frame, float t)
+			{
+				size_t next_frame = frame + 1 >= clip.get_frames_count() ? 0 : frame + 1;
+				if (next_frame > frame)
+				{
+					float begin = clip.timeline[frame], end = clip.timeline[next_frame];
+					clip.sample(begin + (end - begin) * t, pose);
+					return;
+				}
+
+				clip.sample_frame(frame, pose);
+				clip.sample_frame(next_frame, key.pose);
+				for (size_t i = 0; i < pose.size() && i < key.pose.size(); i++)
+				{
+					auto& prev = pose[i];
+					auto& next = key.pose[i];
+					prev.position = prev.position.lerp(next.position, t);
+					prev.scale = prev.scale.lerp(next.scale, t);
+					prev.rotation = prev.rotation.slerp(next.rotation, t);
+				}
+			}
+			void skin_animator::apply_pose(float t)
+			{
+				for (auto&& offset : instance->skeleton.offsets)
+				{
+					if (offset.first >= pose.size() || offset.first >= from.size())
+						continue;
+
+					auto& prev = from[offset.first];
+					auto& next = pose[offset.first];
+					offset.second.frame.position = prev.position.lerp(next.position, t);
+					offset.second.frame.scale = prev.scale.lerp(next.scale, t);
+					offset.second.frame.rotation = prev.rotation.slerp(next.rotation, t);
+					offset.second.offset = offset.second.frame;
 				}
 			}
 			void skin_animator::set_animation(skin_animation* init)
@@ -1754,16 +1813,17 @@ namespace vitex
 			{
 				state.blended = true;
 				state.time = 0.0f;
+				state.span = 0;
 				state.frame = frame;
 				state.clip = clip;
 
 				if (animation != nullptr)
 				{
-					auto& clips = animation->get_clips();
+					auto& clips = animation->get_compressed_clips();
 					if (state.clip >= 0 && (size_t)state.clip < clips.size())
 					{
 						auto& next = clips[(size_t)state.clip];
-						if (state.frame < 0 || (size_t)state.frame >= next.keys.size())
+						if (state.frame < 0 || (size_t)state.frame >= next.get_frames_count())
 							state.frame = -1;
 
 						if (state.duration <= 0.0f)
@@ -1812,11 +1872,11 @@ namespace vitex
 
 				if (animation != nullptr)
 				{
-					auto& clips = animation->get_clips();
+					auto& clips = animation->get_compressed_clips();
 					if (state.clip >= 0 && (size_t)state.clip < clips.size())
 					{
 						auto& next = clips[(size_t)state.clip];
-						if (state.frame < 0 || (size_t)state.frame >= next.keys.size())
+						if (state.frame < 0 || (size_t)state.frame >= next.get_frames_count())
 							state.frame = -1;
 					}
 					else
@@ -1834,7 +1894,7 @@ namespace vitex
 				if (!animation)
 					return false;
 
-				auto& clips = animation->get_clips();
+				auto& clips = animation->get_compressed_clips();
 				return clip >= 0 && (size_t)clip < clips.size();
 			}
 			bool skin_animator::is_exists(int64_t clip, int64_t frame)
@@ -1842,17 +1902,21 @@ namespace vitex
 				if (!is_exists(clip))
 					return false;
 
-				auto& clips = animation->get_clips();
-				return frame >= 0 && (size_t)frame < clips[(size_t)clip].keys.size();
+				auto& clips = animation->get_compressed_clips();
+				return frame >= 0 && (size_t)frame < clips[(size_t)clip].get_frames_count();
 			}
-			const trigonometry::skin_animator_key* skin_animator::get_frame(int64_t clip, int64_t frame)
+			trigonometry::skin_animator_key skin_animator::get_frame(int64_t clip, int64_t frame) const
 			{
 				VI_ASSERT(animation != nullptr, "animation should be set");
-				auto& clips = animation->get_clips();
+				auto& clips = animation->get_compressed_clips();
 
 				VI_ASSERT(clip >= 0 && (size_t)clip < clips.size(), "clip index outside of range");
-				VI_ASSERT(frame >= 0 && (size_t)frame < clips[(size_t)clip].keys.size(), "frame index outside of range");
-				return &clips[(size_t)clip].keys[(size_t)frame];
+				VI_ASSERT(frame >= 0 && (size_t)frame < clips[(size_t)clip].get_frames_count(), "frame index outside of range");
+				auto& target = clips[(size_t)clip];
+				trigonometry::skin_animator_key result;
+				result.time = target.timeline[(size_t)frame];
+				target.sample_frame((size_t)frame, result.pose);
+				return result;
 			}
 			const core::vector<trigonometry::skin_animator_key>* skin_animator::get_clip(int64_t clip)
 			{
@@ -1883,7 +1947,7 @@ namespace vitex
 					return -1;
 
 				size_t index = 0;
-				for (auto& item : animation->get_clips())
+				for (auto& item : animation->get_compressed_clips())
 				{
 					if (item.name == name)
 						return (int64_t)index;
@@ -1897,7 +1961,7 @@ namespace vitex
 				if (!animation)
 					return 0;
 
-				return animation->get_clips().size();
+				return animation->get_compressed_clips().size();
 			}
 			skin_animation* skin_animator::get_animation() const
 			{
@@ -1941,45 +2005,61 @@ namespace vitex
 			}
 			void key_animator::animate(core::timer* time)
 			{
-				auto* transform = parent->get_transform();
 				if (state.paused)
 					return;
 
+				auto* transform = parent->get_transform();
+				bool ticking = parent->get_scene()->tick_animation(parent, state, time);
 				if (!state.blended)
 				{
 					if (state.clip < 0 || (size_t)state.clip >= clips.size() || state.frame < 0 || (size_t)state.frame >= clips[(size_t)state.clip].keys.size())
 						return;
 
+					if (!ticking)
+					{
+						if (state.phase < state.span)
+							apply_offset((float)++state.phase / (float)state.span);
+						return;
+					}
+
 					auto& clip = clips[(size_t)state.clip];
-					auto& next_key = clip.keys[(size_t)state.frame + 1 >= clip.keys.size() ? 0 : (size_t)state.frame + 1];
-					auto& prev_key = clip.keys[(size_t)state.frame];
+					size_t frames = clip.keys.size();
 					state.duration = clip.duration;
-					state.rate = clip.rate * next_key.time;
-					state.time = state.get_timeline(time);
-
-					float t = state.get_progress();
-					offset.position = prev_key.position.lerp(next_key.position, t);
-					offset.rotation = prev_key.rotation.lerp(next_key.rotation, t);
-					offset.scale = prev_key.scale.lerp(next_key.scale, t);
+					state.rate = clip.rate * clip.keys[(size_t)state.frame + 1 >= frames ? 0 : (size_t)state.frame + 1].time;
+					state.time += state.rate * (float)time->get_step() * (float)state.span;
 
-					transform->set_position(offset.position);
-					transform->set_rotation(offset.rotation.get_euler());
-					transform->set_scale(offset.scale);
-
-					if (state.get_progress_total() >= 1.0f)
+					bool finished = false;
+					for (size_t i = 0; i < frames && state.get_progress_total() >= 1.0f; i++)
 					{
-						if (state.frame + 1 >= (int64_t)clip.keys.size())
+						if (state.frame + 1 >= (int64_t)frames && !state.looped)
 						{
-							if (!state.looped)
-								blend_animation(-1, -1);
-							state.frame = -1;
+							finished = true;
+							break;
 						}
 
-						state.time = 0.0f;
-						if (state.looped || state.frame != -1)
-							state.frame++;
+						state.time -= state.get_seconds_duration();
+						state.frame = state.frame + 1 >= (int64_t)frames ? 0 : state.frame + 1;
+						state.rate = clip.rate * clip.keys[(size_t)state.frame + 1 >= frames ? 0 : (size_t)state.frame + 1].time;
 					}
+
+					if (state.get_progress_total() >= 1.0f)
+						state.time = state.get_seconds_duration();
+
+					auto& next_key = clip.keys[(size_t)state.frame + 1 >= frames ? 0 : (size_t)state.frame + 1];
+					auto& prev_key = clip.keys[(size_t)state.frame];
+					float t = state.get_progress();
+					from = offset;
+					target.position = prev_key.position.lerp(next_key.position, t);
+					target.rotation = prev_key.rotation.lerp(next_key.rotation, t);
+					target.scale = prev_key.scale.lerp(next_key.scale, t);
+
+					state.phase = finished ? state.span : 1;
+					apply_offset((float)state.phase / (float)state.span);
+					if (finished)
+						blend_animation(-1, -1);
 				}
+				else if (!ticking)
+					return;
 				else if (state.get_progress_total() < 1.0f)
 				{
 					auto* next = (is_exists(state.clip, state.frame) ? get_frame(state.clip, state.frame) : nullptr);
@@ -1996,8 +2076,20 @@ namespace vitex
 				{
 					state.blended = false;
 					state.time = 0.0f;
+					state.span = 0;
 				}
 			}
+			void key_animator::apply_offset(float t)
+			{
+				offset.position = from.position.lerp(target.position, t);
+				offset.rotation = from.rotation.lerp(target.rotation, t);
+				offset.scale = from.scale.lerp(target.scale, t);
+
+				auto* transform = parent->get_transform();
+				transform->set_position(offset.position);
+				transform->set_rotation(offset.rotation.get_euler());
+				transform->set_scale(offset.scale);
+			}
 			void key_animator::load_animation(const std::string_view& path, std::function<void(bool)>&& callback)
 			{
 				auto* scene = parent->get_scene();
@@ -2029,6 +2121,7 @@ namespace vitex
 			{
 				state.blended = true;
 				state.time = 0.0f;
+				state.span = 0;
 				state.frame = frame;
 				state.clip = clip;
 
@@ -2621,6 +2714,12 @@ namespace vitex
 				}
 
 				audio::audio_context::set_listener_data1f(audio::sound_ex::gain, gain);
+				if (heavy_application::has_instance())
+				{
+					auto* device = heavy_application::get()->audio;
+					if (device != nullptr)
+						device->synchronize_buses(last_position);
+				}
 			}
 			void audio_listener::deactivate()
 			{
@@ -2672,6 +2771,30 @@ namespace vitex
 				series::pack(node->set("shadow-iterations"), shadow.iterations);
 				series::pack(node->set("shadow-enabled"), shadow.enabled);
 			}
+			bool point_light::serialize_binary(core::string& output)
+			{
+				float data[8] = { diffuse.x, diffuse.y, diffuse.z, emission, disperse, size.radius, size.C1, size.C2 };
+				scene_snapshot::write(output, projection.row, sizeof(projection.row));
+				scene_snapshot::write(output, view.row, sizeof(view.row));
+				scene_snapshot::write(output, data, sizeof(data));
+				scene_snapshot::write(output, &shadow, sizeof(shadow));
+				return true;
+			}
+			bool point_light::deserialize_binary(const std::string_view& input)
+			{
+				float data[8];
+				std::string_view next = input;
+				if (!scene_snapshot::read(next, projection.row, sizeof(projection.row)) || !scene_snapshot::read(next, view.row, sizeof(view.row)) || !scene_snapshot::read(next, data, sizeof(data)) || !scene_snapshot::read(next, &shadow, sizeof(shadow)))
+					return false;
+
+				diffuse = trigonometry::vector3(data[0], data[1], data[2]);
+				emission = data[3];
+				disperse = data[4];
+				size.radius = data[5];
+				size.C1 = data[6];
+				size.C2 = data[7];
+				return true;
+			}
 			void point_light::message(const std::string_view& name, core::variant_args& args)
 			{
 				if (name == "depth-flush")
@@ -2750,6 +2873,31 @@ namespace vitex
 				series::pack(node->set("shadow-iterations"), shadow.iterations);
 				series::pack(node->set("shadow-enabled"), shadow.enabled);
 			}
+			bool spot_light::serialize_binary(core::string& output)
+			{
+				float data[9] = { diffuse.x, diffuse.y, diffuse.z, emission, disperse, cutoff, size.radius, size.C1, size.C2 };
+				scene_snapshot::write(output, projection.row, sizeof(projection.row));
+				scene_snapshot::write(output, view.row, sizeof(view.row));
+				scene_snapshot::write(output, data, sizeof(data));
+				scene_snapshot::write(output, &shadow, sizeof(shadow));
+				return true;
+			}
+			bool spot_light::deserialize_binary(const std::string_view& input)
+			{
+				float data[9];
+				std::string_view next = input;
+				if (!scene_snapshot::read(next, projection.row, sizeof(projection.row)) || !scene_snapshot::read(next, view.row, sizeof(view.row)) || !scene_snapshot::read(next, data, sizeof(data)) || !scene_snapshot::read(next, &shadow, sizeof(shadow)))
+					return false;
+
+				diffuse = trigonometry::vector3(data[0], data[1], data[2]);
+				emission = data[3];
+				disperse = data[4];
+				cutoff = data[5];
+				size.radius = data[6];
+				size.C1 = data[7];
+				size.C2 = data[8];
+				return true;
+			}
 			void spot_light::message(const std::string_view& name, core::variant_args& args)
 			{
 				if (name == "depth-flush")
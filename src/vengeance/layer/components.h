@@ -16,6 +16,15 @@ namespace vitex
 				core::vector<trigonometry::vertex> vertices;
 				core::vector<int> indices;
 
+			public:
+				struct
+				{
+					size_t frame = std::numeric_limits<size_t>::max();
+					uint32_t vertex_offset = 0;
+					uint32_t index_offset = 0;
+					uint32_t index_count = 0;
+				} streaming;
+
 			public:
 				trigonometry::vector2 texcoord = 1.0f;
 				bool kinematic = false;
@@ -139,6 +148,7 @@ namespace vitex
 
 			public:
 				trigonometry::vector2 texcoord = 1.0f;
+				size_t level = 0;
 
 			public:
 				model(entity* ref);
@@ -230,6 +240,9 @@ namespace vitex
 			private:
 				skin* instance = nullptr;
 				skin_animation* animation = nullptr;
+				core::vector<trigonometry::animator_key> pose;
+				core::vector<pose_node> from;
+				trigonometry::skin_animator_key key;
 
 			public:
 				animator_state state;
@@ -248,7 +261,7 @@ namespace vitex
 				void stop();
 				bool is_exists(int64_t clip);
 				bool is_exists(int64_t clip, int64_t frame);
-				const trigonometry::skin_animator_key* get_frame(int64_t clip, int64_t frame);
+				trigonometry::skin_animator_key get_frame(int64_t clip, int64_t frame) const;
 				const core::vector<trigonometry::skin_animator_key>* get_clip(int64_t clip);
 				int64_t get_clip_by_name(const std::string_view& name) const;
 				size_t get_clips_count() const;
@@ -257,6 +270,8 @@ namespace vitex
 				core::string get_path() const;
 
 			private:
+				void sample_pose(const trigonometry::skin_animator_compressed_clip& clip, size_t frame, float t);
+				void apply_pose(float t);
 				void blend_animation(int64_t clip, int64_t frame);
 				void save_binding_state();
 
@@ -267,6 +282,8 @@ namespace vitex
 			class key_animator final : public component
 			{
 			private:
+				trigonometry::animator_key from;
+				trigonometry::animator_key target;
 				core::string reference;
 
 			public:
@@ -294,6 +311,7 @@ namespace vitex
 				core::string get_path();
 
 			private:
+				void apply_offset(float t);
 				void blend_animation(int64_t clip, int64_t frame);
 				void save_binding_state();
 
@@ -459,6 +477,8 @@ namespace vitex
 				point_light(entity* ref);
 				void deserialize(core::schema* node) override;
 				void serialize(core::schema* node) override;
+				bool serialize_binary(core::string& output) override;
+				bool deserialize_binary(const std::string_view& input) override;
 				void message(const std::string_view& name, core::variant_args& args) override;
 				size_t get_unit_bounds(trigonometry::vector3& min, trigonometry::vector3& max) const override;
 				float get_visibility(const viewer& view, float distance) const override;
@@ -499,6 +519,8 @@ namespace vitex
 				spot_light(entity* ref);
 				void deserialize(core::schema* node) override;
 				void serialize(core::schema* node) override;
+				bool serialize_binary(core::string& output) override;
+				bool deserialize_binary(const std::string_view& input) override;
 				void message(const std::string_view& name, core::variant_args& args) override;
 				void synchronize(core::timer* time) override;
 				size_t get_unit_bounds(trigonometry::vector3& min, trigonometry::vector3& max) const override;
@@ -6,6 +6,7 @@
 #include <RmlUi/Core/RenderInterfaceCompatibility.h>
 #include <Source/Core/StyleSheetFactory.h>
 #include <Source/Core/ElementStyle.h>
+#include <Source/Core/FontEngineDefault/FontEngineInterfaceDefault.h>
 #endif
 #define RENDERS_FOR_DATA_EVENT 1
 #define RENDERS_FOR_SIZE_EVENT 30
@@ -45,6 +46,21 @@ namespace vitex
 					uint32_t object = (uint32_t)-1;
 				} slots;
 
+				struct
+				{
+					core::vector<Rml::Vertex> vertices;
+					core::vector<uint32_t> indices;
+					graphics::texture_2d* texture = nullptr;
+				} batch;
+
+				struct
+				{
+					graphics::element_buffer* vertex_buffer = nullptr;
+					graphics::element_buffer* index_buffer = nullptr;
+					size_t vertex_offset = 0;
+					size_t index_offset = 0;
+				} arena;
+
 			private:
 				graphics::rasterizer_state* scissor_none_rasterizer;
 				graphics::rasterizer_state* none_rasterizer;
@@ -92,24 +108,23 @@ namespace vitex
 					VI_ASSERT(device != nullptr, "graphics device should be set");
 					VI_ASSERT(vertices != nullptr, "vertices should be set");
 					VI_ASSERT(indices != nullptr, "indices should be set");
-					EnableScissorRegion(has_scissor);
-					device->im_begin();
-					device->im_topology(graphics::primitive_topology::triangle_list);
-					device->im_texture((graphics::texture_2d*)texture);
-					if (has_transform)
-						device->im_transform(trigonometry::matrix4x4::create_translation(trigonometry::vector3(translation.x, translation.y)) * transform * ortho);
-					else
-						device->im_transform(trigonometry::matrix4x4::create_translation(trigonometry::vector3(translation.x, translation.y)) * ortho);
-
-					for (int i = indices_size; i-- > 0;)
+					graphics::texture_2d* target = (graphics::texture_2d*)texture;
+					if (batch.texture != target)
+						flush();
+
+					uint32_t base = (uint32_t)batch.vertices.size();
+					batch.texture = target;
+					batch.vertices.reserve(batch.vertices.size() + (size_t)vertices_size);
+					for (int i = 0; i < vertices_size; i++)
 					{
-						Rml::Vertex& v = vertices[indices[i]];
-						device->im_emit();
-						device->im_position(v.position.x, v.position.y, 0.0f);
-						device->im_texcoord(v.tex_coord.x, v.tex_coord.y);
-						device->im_color(v.colour.red / 255.0f, v.colour.green / 255.0f, v.colour.blue / 255.0f, v.colour.alpha / 255.0f);
+						Rml::Vertex& v = vertices[i];
+						batch.vertices.push_back(v);
+						batch.vertices.back().position += translation;
 					}
-					device->im_end();
+
+					batch.indices.reserve(batch.indices.size() + (size_t)indices_size);
+					for (int i = 0; i < indices_size; i++)
+						batch.indices.push_back(base + (uint32_t)indices[i]);
 				}
 				Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int vertices_count, int* indices, int indices_count, Rml::TextureHandle handle) override
 				{
@@ -142,6 +157,7 @@ namespace vitex
 					geometry_buffer* buffer = (geometry_buffer*)handle;
 					VI_ASSERT(device != nullptr, "graphics device should be set");
 					VI_ASSERT(buffer != nullptr, "buffer should be set");
+					flush();
 
 					constants->render.diffuse = (buffer->texture != nullptr ? 1.0f : 0.0f);
 					if (has_transform)
@@ -149,7 +165,7 @@ namespace vitex
 					else
 						constants->render.transform = trigonometry::matrix4x4::create_translation(trigonometry::vector3(translation.x, translation.y)) * ortho;
 
-					EnableScissorRegion(has_scissor);
+					set_scissor_state(has_scissor);
 					constants->set_updated_constant_buffer(render_buffer_type::render, slots.object, VI_VS | VI_PS);
 					device->set_input_layout(layout);
 					device->set_shader(shader, VI_VS | VI_PS);
@@ -166,32 +182,13 @@ namespace vitex
 				void EnableScissorRegion(bool enable) override
 				{
 					VI_ASSERT(device != nullptr, "graphics device should be set");
-					has_scissor = enable;
-					ortho = trigonometry::matrix4x4::create_orthographic_off_center(0, (float)device->get_render_target()->get_width(), (float)device->get_render_target()->get_height(), 0.0f, -30000.0f, 10000.0f);
-					device->set_sampler_state(sampler, slots.sampler, 1, VI_PS);
-					device->set_blend_state(alpha_blend);
-					if (enable)
-					{
-						if (has_transform)
-						{
-							device->set_rasterizer_state(none_rasterizer);
-							device->set_depth_stencil_state(less_depth_stencil);
-						}
-						else
-						{
-							device->set_rasterizer_state(scissor_none_rasterizer);
-							device->set_depth_stencil_state(none_depth_stencil);
-						}
-					}
-					else
-					{
-						device->set_rasterizer_state(none_rasterizer);
-						device->set_depth_stencil_state(none_depth_stencil);
-					}
+					flush();
+					set_scissor_state(enable);
 				}
 				void SetScissorRegion(int x, int y, int width, int height) override
 				{
 					VI_ASSERT(device != nullptr, "graphics device should be set");
+					flush();
 					if (!has_transform)
 					{
 						trigonometry::rectangle scissor;
@@ -270,10 +267,56 @@ namespace vitex
 				}
 				void SetTransform(const Rml::Matrix4f* new_transform) override
 				{
+					flush();
 					has_transform = (new_transform != nullptr);
 					if (has_transform)
 						transform = utils::to_matrix(new_transform);
 				}
+				void flush()
+				{
+					if (batch.indices.empty())
+						return;
+
+					size_t vertex_count = batch.vertices.size();
+					size_t index_count = batch.indices.size();
+					graphics::resource_map mode;
+					if (!reserve_arena(vertex_count, index_count, &mode))
+					{
+						batch.vertices.clear();
+						batch.indices.clear();
+						return;
+					}
+
+					graphics::mapped_subresource vertex_stream;
+					if (device->map(arena.vertex_buffer, mode, &vertex_stream))
+					{
+						memcpy((Rml::Vertex*)vertex_stream.pointer + arena.vertex_offset, batch.vertices.data(), sizeof(Rml::Vertex) * vertex_count);
+						device->unmap(arena.vertex_buffer, &vertex_stream);
+					}
+
+					graphics::mapped_subresource index_stream;
+					if (device->map(arena.index_buffer, mode, &index_stream))
+					{
+						memcpy((uint32_t*)index_stream.pointer + arena.index_offset, batch.indices.data(), sizeof(uint32_t) * index_count);
+						device->unmap(arena.index_buffer, &index_stream);
+					}
+
+					set_scissor_state(has_scissor);
+					constants->render.diffuse = (batch.texture != nullptr ? 1.0f : 0.0f);
+					constants->render.transform = (has_transform ? transform * ortho : ortho);
+					constants->set_updated_constant_buffer(render_buffer_type::render, slots.object, VI_VS | VI_PS);
+					device->set_input_layout(layout);
+					device->set_shader(shader, VI_VS | VI_PS);
+					device->set_texture_2d(batch.texture, slots.diffuse_map, VI_PS);
+					device->set_vertex_buffer(arena.vertex_buffer);
+					device->set_index_buffer(arena.index_buffer, graphics::format::r32_uint);
+					device->draw_indexed((unsigned int)index_count, (unsigned int)arena.index_offset, (unsigned int)arena.vertex_offset);
+
+					arena.vertex_offset += vertex_count;
+					arena.index_offset += index_count;
+					batch.vertices.clear();
+					batch.indices.clear();
+				}
 				void attach(render_constants* new_constants, heavy_content_manager* new_content)
 				{
 					VI_ASSERT(new_constants != nullptr, "render constants should be set");
@@ -321,6 +364,13 @@ namespace vitex
 				{
 					subsystem::get()->release_decorators();
 					core::memory::release(vertex_buffer);
+					core::memory::release(arena.vertex_buffer);
+					core::memory::release(arena.index_buffer);
+					arena.vertex_offset = 0;
+					arena.index_offset = 0;
+					batch.vertices.clear();
+					batch.indices.clear();
+					batch.texture = nullptr;
 					core::memory::release(shader);
 					core::memory::release(constants);
 					core::memory::release(content);
@@ -346,6 +396,74 @@ namespace vitex
 				{
 					return &ortho;
 				}
+
+			private:
+				bool reserve_arena(size_t vertex_count, size_t index_count, graphics::resource_map* mode)
+				{
+					size_t vertex_capacity = arena.vertex_buffer ? (size_t)arena.vertex_buffer->get_elements() : 0;
+					size_t index_capacity = arena.index_buffer ? (size_t)arena.index_buffer->get_elements() : 0;
+					if (arena.vertex_offset + vertex_count <= vertex_capacity && arena.index_offset + index_count <= index_capacity)
+					{
+						*mode = (arena.index_offset > 0 ? graphics::resource_map::write_no_overwrite : graphics::resource_map::write_discard);
+						return true;
+					}
+
+					*mode = graphics::resource_map::write_discard;
+					arena.vertex_offset = 0;
+					arena.index_offset = 0;
+					if (vertex_count > vertex_capacity)
+					{
+						graphics::element_buffer::desc f = graphics::element_buffer::desc();
+						f.access_flags = graphics::cpu_access::write;
+						f.usage = graphics::resource_usage::dynamic;
+						f.bind_flags = graphics::resource_bind::vertex_buffer;
+						f.element_count = (unsigned int)std::max<size_t>(std::max<size_t>(vertex_count, vertex_capacity * 2), 4096);
+						f.element_width = sizeof(Rml::Vertex);
+
+						core::memory::release(arena.vertex_buffer);
+						arena.vertex_buffer = device->create_element_buffer(f).or_else(nullptr);
+					}
+
+					if (index_count > index_capacity)
+					{
+						graphics::element_buffer::desc f = graphics::element_buffer::desc();
+						f.access_flags = graphics::cpu_access::write;
+						f.usage = graphics::resource_usage::dynamic;
+						f.bind_flags = graphics::resource_bind::index_buffer;
+						f.element_count = (unsigned int)std::max<size_t>(std::max<size_t>(index_count, index_capacity * 2), 8192);
+						f.element_width = sizeof(uint32_t);
+
+						core::memory::release(arena.index_buffer);
+						arena.index_buffer = device->create_element_buffer(f).or_else(nullptr);
+					}
+
+					return arena.vertex_buffer != nullptr && arena.index_buffer != nullptr;
+				}
+				void set_scissor_state(bool enable)
+				{
+					has_scissor = enable;
+					ortho = trigonometry::matrix4x4::create_orthographic_off_center(0, (float)device->get_render_target()->get_width(), (float)device->get_render_target()->get_height(), 0.0f, -30000.0f, 10000.0f);
+					device->set_sampler_state(sampler, slots.sampler, 1, VI_PS);
+					device->set_blend_state(alpha_blend);
+					if (enable)
+					{
+						if (has_transform)
+						{
+							device->set_rasterizer_state(none_rasterizer);
+							device->set_depth_stencil_state(less_depth_stencil);
+						}
+						else
+						{
+							device->set_rasterizer_state(scissor_none_rasterizer);
+							device->set_depth_stencil_state(none_depth_stencil);
+						}
+					}
+					else
+					{
+						device->set_rasterizer_state(none_rasterizer);
+						device->set_depth_stencil_state(none_depth_stencil);
+					}
+				}
 			};
 
 			class file_subsystem final : public Rml::FileInterface
@@ -396,6 +514,169 @@ namespace vitex
 				}
 			};
 
+			class font_subsystem final : public Rml::FontEngineInterfaceDefault
+			{
+			private:
+				struct width_entry
+				{
+					core::string text;
+					uint64_t tick = 0;
+					int version = 0;
+					int width = 0;
+				};
+
+				struct geometry_entry
+				{
+					core::string text;
+					Rml::TexturedMeshList meshes;
+					uint64_t tick = 0;
+					int version = 0;
+					int width = 0;
+				};
+
+			private:
+				core::unordered_map<uint64_t, width_entry> widths;
+				core::unordered_map<uint64_t, geometry_entry> geometries;
+				text_cache_info info;
+				uint64_t tick;
+				size_t capacity;
+
+			public:
+				font_subsystem() : Rml::FontEngineInterfaceDefault(), tick(0), capacity(4096)
+				{
+				}
+				~font_subsystem() override = default;
+				int GetStringWidth(Rml::FontFaceHandle handle, Rml::StringView string, const Rml::TextShapingContext& text_shaping_context, Rml::Character prior_character) override
+				{
+					std::string_view text(string.begin(), string.end() - string.begin());
+					uint64_t key = get_key(text, { (uint64_t)handle, (uint64_t)prior_character, (uint64_t)get_bits(text_shaping_context.letter_spacing) });
+					int version = GetVersion(handle);
+					auto it = widths.find(key);
+					if (it != widths.end() && it->second.version == version && it->second.text == text)
+					{
+						it->second.tick = ++tick;
+						++info.width_hits;
+						return it->second.width;
+					}
+
+					++info.width_misses;
+					auto& entry = widths[key];
+					entry.text = text;
+					entry.tick = ++tick;
+					entry.version = version;
+					entry.width = Rml::FontEngineInterfaceDefault::GetStringWidth(handle, string, text_shaping_context, prior_character);
+
+					int width = entry.width;
+					if (widths.size() > capacity)
+						evict(widths);
+
+					return width;
+				}
+				int GenerateString(Rml::RenderManager& render_manager, Rml::FontFaceHandle face_handle, Rml::FontEffectsHandle font_effects_handle, Rml::StringView string, Rml::Vector2f position, Rml::ColourbPremultiplied colour, float opacity, const Rml::TextShapingContext& text_shaping_context, Rml::TexturedMeshList& mesh_list) override
+				{
+					Rml::Vector2f origin(std::floor(position.x), std::floor(position.y));
+					Rml::Vector2f fraction = position - origin;
+					std::string_view text(string.begin(), string.end() - string.begin());
+					uint64_t key = get_key(text, { (uint64_t)face_handle, (uint64_t)font_effects_handle, (uint64_t)&render_manager, ((uint64_t)colour.red << 24) | ((uint64_t)colour.green << 16) | ((uint64_t)colour.blue << 8) | (uint64_t)colour.alpha, ((uint64_t)get_bits(fraction.x) << 32) | (uint64_t)get_bits(fraction.y), ((uint64_t)get_bits(opacity) << 32) | (uint64_t)get_bits(text_shaping_context.letter_spacing) });
+					int version = GetVersion(face_handle);
+					auto it = geometries.find(key);
+					if (it != geometries.end() && it->second.version == version && it->second.text == text)
+					{
+						it->second.tick = ++tick;
+						++info.geometry_hits;
+						append_meshes(it->second.meshes, origin, mesh_list);
+						return it->second.width;
+					}
+
+					++info.geometry_misses;
+					auto& entry = geometries[key];
+					entry.text = text;
+					entry.tick = ++tick;
+					entry.version = version;
+					entry.meshes.clear();
+					entry.width = Rml::FontEngineInterfaceDefault::GenerateString(render_manager, face_handle, font_effects_handle, string, fraction, colour, opacity, text_shaping_context, entry.meshes);
+					append_meshes(entry.meshes, origin, mesh_list);
+
+					int width = entry.width;
+					if (geometries.size() > capacity)
+						evict(geometries);
+
+					return width;
+				}
+				void ReleaseFontResources() override
+				{
+					clear();
+					Rml::FontEngineInterfaceDefault::ReleaseFontResources();
+				}
+				void clear()
+				{
+					info.evictions += widths.size() + geometries.size();
+					widths.clear();
+					geometries.clear();
+				}
+				void set_capacity(size_t new_capacity)
+				{
+					capacity = std::max<size_t>(new_capacity, 1);
+					if (widths.size() > capacity)
+						evict(widths);
+					if (geometries.size() > capacity)
+						evict(geometries);
+				}
+				text_cache_info get_info() const
+				{
+					text_cache_info result = info;
+					result.entries = widths.size() + geometries.size();
+					return result;
+				}
+
+			private:
+				template <typename t>
+				void evict(core::unordered_map<uint64_t, t>& entries)
+				{
+					core::vector<uint64_t> ticks;
+					ticks.reserve(entries.size());
+					for (auto& item : entries)
+						ticks.push_back(item.second.tick);
+
+					size_t keep = capacity / 2;
+					std::nth_element(ticks.begin(), ticks.begin() + (ticks.size() - keep - 1), ticks.end());
+					uint64_t threshold = ticks[ticks.size() - keep - 1];
+					for (auto it = entries.begin(); it != entries.end();)
+					{
+						if (it->second.tick <= threshold)
+						{
+							it = entries.erase(it);
+							++info.evictions;
+						}
+						else
+							++it;
+					}
+				}
+				static void append_meshes(const Rml::TexturedMeshList& source, const Rml::Vector2f& origin, Rml::TexturedMeshList& target)
+				{
+					target.reserve(target.size() + source.size());
+					for (auto& item : source)
+					{
+						target.push_back(item);
+						for (auto& vertex : target.back().mesh.vertices)
+							vertex.position += origin;
+					}
+				}
+				static uint32_t get_bits(float value)
+				{
+					uint32_t bits;
+					memcpy(&bits, &value, sizeof(bits));
+					return bits;
+				}
+				static uint64_t get_key(const std::string_view& text, std::initializer_list<uint64_t> values)
+				{
+					uint64_t seed = (uint64_t)std::hash<std::string_view>()(text);
+					for (uint64_t value : values)
+						seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+					return seed;
+				}
+			};
+
 			class main_subsystem final : public Rml::SystemInterface
 			{
 			private:
@@ -2825,7 +3106,7 @@ namespace vitex
 				return copy;
 			}
 
-			subsystem::subsystem() noexcept : context_factory(nullptr), document_factory(nullptr), listener_factory(nullptr), render_interface(nullptr), file_interface(nullptr), system_interface(nullptr), id(0)
+			subsystem::subsystem() noexcept : context_factory(nullptr), document_factory(nullptr), listener_factory(nullptr), render_interface(nullptr), file_interface(nullptr), font_interface(nullptr), system_interface(nullptr), id(0)
 			{
 #ifdef VI_RMLUI
 				render_interface = core::memory::init<render_subsystem>();
@@ -2834,6 +3115,9 @@ namespace vitex
 				file_interface = core::memory::init<file_subsystem>();
 				Rml::SetFileInterface(file_interface);
 
+				font_interface = core::memory::init<font_subsystem>();
+				Rml::SetFontEngineInterface(font_interface);
+
 				system_interface = core::memory::init<main_subsystem>();
 				Rml::SetSystemInterface(system_interface);
 
@@ -2861,6 +3145,9 @@ namespace vitex
 				core::memory::deinit(file_interface);
 				file_interface = nullptr;
 
+				core::memory::deinit(font_interface);
+				font_interface = nullptr;
+
 				core::memory::deinit(render_interface);
 				render_interface = nullptr;
 
@@ -2921,6 +3208,10 @@ namespace vitex
 			{
 				return file_interface;
 			}
+			font_subsystem* subsystem::get_font_interface() noexcept
+			{
+				return font_interface;
+			}
 			main_subsystem* subsystem::get_system_interface() noexcept
 			{
 				return system_interface;
@@ -2961,6 +3252,36 @@ namespace vitex
 				return nullptr;
 #endif
 			}
+			void subsystem::flush_render() noexcept
+			{
+#ifdef VI_RMLUI
+				VI_ASSERT(render_interface != nullptr, "render interface should be valid");
+				render_interface->flush();
+#endif
+			}
+			void subsystem::set_text_cache_capacity(size_t capacity) noexcept
+			{
+#ifdef VI_RMLUI
+				VI_ASSERT(font_interface != nullptr, "font interface should be valid");
+				font_interface->set_capacity(capacity);
+#endif
+			}
+			void subsystem::clear_text_cache() noexcept
+			{
+#ifdef VI_RMLUI
+				VI_ASSERT(font_interface != nullptr, "font interface should be valid");
+				font_interface->clear();
+#endif
+			}
+			text_cache_info subsystem::get_text_cache_info() noexcept
+			{
+#ifdef VI_RMLUI
+				VI_ASSERT(font_interface != nullptr, "font interface should be valid");
+				return font_interface->get_info();
+#else
+				return text_cache_info();
+#endif
+			}
 
 			data_model::data_model(Rml::DataModelConstructor* ref) : base(nullptr)
 			{
@@ -3697,6 +4018,7 @@ namespace vitex
 				render_subsystem* renderer = subsystem::get()->get_render_interface();
 				renderer->background = target;
 				base->Render();
+				renderer->flush();
 #endif
 			}
 			void context::clear_styles()
@@ -33,6 +33,8 @@ namespace vitex
 
 			class file_subsystem;
 
+			class font_subsystem;
+
 			class main_subsystem;
 
 			class scoped_context;
@@ -232,6 +234,16 @@ namespace vitex
 				bool fallback;
 			};
 
+			struct text_cache_info
+			{
+				size_t width_hits = 0;
+				size_t width_misses = 0;
+				size_t geometry_hits = 0;
+				size_t geometry_misses = 0;
+				size_t evictions = 0;
+				size_t entries = 0;
+			};
+
 			class ivariant
 			{
 			public:
@@ -481,6 +493,7 @@ namespace vitex
 				listener_instancer* listener_factory;
 				render_subsystem* render_interface;
 				file_subsystem* file_interface;
+				font_subsystem* font_interface;
 				main_subsystem* system_interface;
 				uint64_t id;
 
@@ -492,11 +505,16 @@ namespace vitex
 				void cleanup_shared();
 				render_subsystem* get_render_interface() noexcept;
 				file_subsystem* get_file_interface() noexcept;
+				font_subsystem* get_font_interface() noexcept;
 				main_subsystem* get_system_interface() noexcept;
 				graphics::graphics_device* get_device() noexcept;
 				graphics::texture_2d* get_background() noexcept;
 				trigonometry::matrix4x4* get_transform() noexcept;
 				trigonometry::matrix4x4* get_projection() noexcept;
+				void flush_render() noexcept;
+				void set_text_cache_capacity(size_t capacity) noexcept;
+				void clear_text_cache() noexcept;
+				text_cache_info get_text_cache_info() noexcept;
 
 			private:
 				void resize_decorators(int width, int height) noexcept;
@@ -138,6 +138,7 @@ namespace vitex
 				void RenderElement(Rml::Element* element, Rml::DecoratorDataHandle element_data) const override
 				{
 					VI_ASSERT(element != nullptr, "element should be set");
+					subsystem::get()->flush_render();
 					Rml::Vector2f position = element->GetAbsoluteOffset(Rml::BoxArea::Padding).Round();
 					Rml::Vector2f size = element->GetBox().GetSize(Rml::BoxArea::Padding).Round();
 					float alpha = element->GetProperty<float>("opacity");
@@ -191,6 +192,7 @@ namespace vitex
 					if (!background)
 						return;
 
+					subsystem::get()->flush_render();
 					Rml::Vector2i screen = element->GetContext()->GetDimensions();
 					Rml::Vector2f position = element->GetAbsoluteOffset(Rml::BoxArea::Padding).Round();
 					Rml::Vector2f size = element->GetBox().GetSize(Rml::BoxArea::Padding).Round();
@@ -589,6 +589,37 @@ namespace vitex
 
 				return result;
 			}
+			bool simplify_mesh(const graphics::mesh_buffer::desc& source, graphics::mesh_buffer::desc& target, size_t target_count, size_t previous_count, float max_error, float* result_error)
+			{
+				core::vector<trigonometry::vector3> positions;
+				positions.reserve(source.elements.size());
+				for (auto& vertex : source.elements)
+					positions.emplace_back(vertex.position_x, vertex.position_y, vertex.position_z);
+
+				auto indices = trigonometry::geometric::simplify_triangle_list(positions, source.indices, target_count, max_error, result_error);
+				if (indices.empty() || indices.size() * 10 > previous_count * 9)
+					return false;
+
+				trigonometry::geometric::optimize_vertex_cache(indices, source.elements.size());
+				core::vector<int> remap(source.elements.size(), -1);
+				target.access_flags = source.access_flags;
+				target.usage = source.usage;
+				target.elements.clear();
+				target.indices.clear();
+				target.indices.reserve(indices.size());
+				for (int index : indices)
+				{
+					int& next = remap[index];
+					if (next < 0)
+					{
+						next = (int)target.elements.size();
+						target.elements.push_back(source.elements[index]);
+					}
+					target.indices.push_back(next);
+				}
+
+				return true;
+			}
 			template <typename t>
 			t process_renderer_job(graphics::graphics_device* device, std::function<t(graphics::graphics_device*)>&& callback)
 			{
@@ -620,6 +651,7 @@ namespace vitex
 			}
 			expects_content<void*> material_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("material_processor::deserialize");
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				auto data_status = content->load<core::schema>(stream->virtual_name());
 				if (!data_status)
@@ -790,6 +822,7 @@ namespace vitex
 			}
 			expects_content<void*> scene_graph_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("scene_graph_processor::deserialize");
 				layer::scene_graph::desc i = layer::scene_graph::desc::get(heavy_application::has_instance() ? heavy_application::get() : nullptr);
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				VI_ASSERT(i.shared.device != nullptr, "graphics device should be set");
@@ -814,6 +847,18 @@ namespace vitex
 						heavy_series::unpack(simulator->find("gravity"), &i.simulator.gravity);
 					}
 
+					core::schema* animation = metadata->find("animation");
+					if (animation != nullptr)
+					{
+						series::unpack(animation->find("enabled"), &i.animation.enabled);
+						series::unpack(animation->find("freeze-invisible"), &i.animation.freeze_invisible);
+						series::unpack(animation->find("full-distance"), &i.animation.distances[(size_t)layer::animation_tier::full]);
+						series::unpack(animation->find("reduced-distance"), &i.animation.distances[(size_t)layer::animation_tier::reduced]);
+						series::unpack(animation->find("minimal-distance"), &i.animation.distances[(size_t)layer::animation_tier::minimal]);
+						series::unpack_a(animation->find("reduced-interval"), &i.animation.intervals[(size_t)layer::animation_tier::reduced]);
+						series::unpack_a(animation->find("minimal-interval"), &i.animation.intervals[(size_t)layer::animation_tier::minimal]);
+					}
+
 					series::unpack_a(metadata->find("materials"), &i.start_materials);
 					series::unpack_a(metadata->find("entities"), &i.start_entities);
 					series::unpack_a(metadata->find("components"), &i.start_components);
@@ -853,20 +898,63 @@ namespace vitex
 				if (materials != nullptr)
 				{
 					core::vector<core::schema*> collection = materials->find_collection("material");
+					core::vector<material_request> requests;
+					core::unordered_map<core::string, size_t> origins;
+					requests.reserve(collection.size());
 					for (auto& it : collection)
 					{
-						core::string path;
-						if (!series::unpack(it, &path) || path.empty())
+						material_request request;
+						if (!series::unpack(it, &request.path) || request.path.empty())
 							continue;
 
-						auto value = content->load<layer::material>(path);
+						request.node = it;
+						request.origin = origins.emplace(request.path, requests.size()).first->second;
+						requests.emplace_back(std::move(request));
+					}
+
+					core::vector<material_request*> prefetch;
+					prefetch.reserve(origins.size());
+					for (size_t i = 0; i < requests.size(); i++)
+					{
+						if (requests[i].origin == i)
+							prefetch.push_back(&requests[i]);
+					}
+
+					parallel::wail_all(parallel::for_each(prefetch.begin(), prefetch.end(), THRESHOLD_PER_THREAD, [this](material_request* request)
+					{
+						auto value = content->load<layer::material>(request->path);
 						if (value)
+							request->value = *value;
+						else
+							request->error = value.error().message();
+					}));
+
+					for (size_t i = 0; i < requests.size(); i++)
+					{
+						auto& request = requests[i];
+						if (request.origin != i)
+						{
+							auto value = content->load<layer::material>(request.path);
+							if (value)
+								request.value = *value;
+							else
+								request.error = value.error().message();
+						}
+
+						if (request.value != nullptr)
 						{
-							series::unpack_a(it, &value->slot);
-							object->add_material(*value);
+							series::unpack_a(request.node, &request.value->slot);
+							object->add_material(request.value);
 						}
 						else if (integrity_check)
-							return value.error();
+						{
+							for (size_t j = i + 1; j < requests.size(); j++)
+							{
+								if (requests[j].origin == j)
+									core::memory::release(requests[j].value);
+							}
+							return content_exception(std::move(request.error));
+						}
 					}
 				}
 
@@ -874,30 +962,31 @@ namespace vitex
 				if (entities != nullptr)
 				{
 					core::vector<core::schema*> collection = entities->find_collection("entity");
-					for (auto& it : collection)
+					core::vector<entity*> array = object->add_entities(collection.size());
+					core::vector<std::pair<entity*, core::schema*>> nodes;
+					nodes.reserve(collection.size());
+					for (size_t i = 0; i < collection.size(); i++)
 					{
-						entity* entity = object->add_entity();
+						entity* entity = array[i];
 						int64_t refer = -1;
 
-						if (series::unpack(it->find("refer"), &refer) && refer >= 0)
+						if (series::unpack(collection[i]->find("refer"), &refer) && refer >= 0)
 						{
 							snapshot.to[entity] = (size_t)refer;
 							snapshot.from[(size_t)refer] = entity;
 						}
+
+						nodes.emplace_back(entity, collection[i]);
 					}
 
-					size_t next = 0;
-					for (auto& it : collection)
+					parallel::wail_all(parallel::for_each(nodes.begin(), nodes.end(), THRESHOLD_PER_ELEMENT, [](std::pair<entity*, core::schema*>& node)
 					{
-						entity* entity = object->get_entity(next++);
-						if (!entity)
-							continue;
-
+						entity* entity = node.first;
 						core::string name;
-						series::unpack(it->find("name"), &name);
+						series::unpack(node.second->find("name"), &name);
 						entity->set_name(name);
 
-						core::schema* transform = it->find("transform");
+						core::schema* transform = node.second->find("transform");
 						if (transform != nullptr)
 						{
 							trigonometry::transform* offset = entity->get_transform();
@@ -909,7 +998,12 @@ namespace vitex
 							series::unpack(transform->find("scaling"), &scaling);
 							offset->set_scaling(scaling);
 						}
+					}));
 
+					for (auto& node : nodes)
+					{
+						entity* entity = node.first;
+						core::schema* it = node.second;
 						core::schema* parent = it->find("parent");
 						if (parent != nullptr)
 						{
@@ -1023,6 +1117,15 @@ namespace vitex
 				heavy_series::pack(simulator->set("water-normal"), fSimulator->get_water_normal());
 				heavy_series::pack(simulator->set("gravity"), fSimulator->get_gravity());
 
+				core::schema* animation = metadata->set("animation");
+				series::pack(animation->set("enabled"), conf.animation.enabled);
+				series::pack(animation->set("freeze-invisible"), conf.animation.freeze_invisible);
+				series::pack(animation->set("full-distance"), conf.animation.distances[(size_t)layer::animation_tier::full]);
+				series::pack(animation->set("reduced-distance"), conf.animation.distances[(size_t)layer::animation_tier::reduced]);
+				series::pack(animation->set("minimal-distance"), conf.animation.distances[(size_t)layer::animation_tier::minimal]);
+				series::pack(animation->set("reduced-interval"), (uint64_t)conf.animation.intervals[(size_t)layer::animation_tier::reduced]);
+				series::pack(animation->set("minimal-interval"), (uint64_t)conf.animation.intervals[(size_t)layer::animation_tier::minimal]);
+
 				core::schema* materials = blob->set("materials", core::var::array());
 				for (size_t i = 0; i < object->get_materials_count(); i++)
 				{
@@ -1114,6 +1217,7 @@ namespace vitex
 			}
 			expects_content<void*> audio_clip_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("audio_clip_processor::deserialize");
 				if (core::stringify::ends_with(stream->virtual_name(), ".wav"))
 					return deserialize_wave(stream, offset, args);
 				else if (core::stringify::ends_with(stream->virtual_name(), ".ogg"))
@@ -1240,6 +1344,7 @@ namespace vitex
 			}
 			expects_content<void*> texture_2d_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("texture_2d_processor::deserialize");
 #ifdef VI_STB
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				core::vector<char> data;
@@ -1305,6 +1410,7 @@ namespace vitex
 			}
 			expects_content<void*> shader_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("shader_processor::deserialize");
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				core::string data;
 				stream->read_all([&data](uint8_t* buffer, size_t size) { data.append((char*)buffer, size); });
@@ -1351,6 +1457,7 @@ namespace vitex
 			}
 			expects_content<void*> model_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("model_processor::deserialize");
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				core::uptr<model> object = new model();
 				auto path = stream->virtual_name();
@@ -1389,6 +1496,10 @@ namespace vitex
 							object->meshes.emplace_back(*new_buffer);
 							series::unpack(mesh->get("name"), &new_buffer->name);
 							heavy_series::unpack(mesh->get("transform"), &new_buffer->transform);
+
+							auto status = create_levels(*object, object->meshes.size() - 1, i);
+							if (!status)
+								return status.error();
 						}
 					}
 				}
@@ -1418,6 +1529,10 @@ namespace vitex
 						object->meshes.emplace_back(*new_buffer);
 						new_buffer->name = mesh.name;
 						new_buffer->transform = mesh.transform;
+
+						auto status = create_levels(*object, object->meshes.size() - 1, i);
+						if (!status)
+							return status.error();
 					}
 				}
 
@@ -1480,6 +1595,14 @@ namespace vitex
 				model_info info;
 				fill_scene_geometries(&info, scene, scene->mRootNode, scene->mRootNode->mTransformation);
 				fill_scene_skeletons(&info, scene);
+				for (auto& mesh : info.meshes)
+				{
+					if (mesh.indices.size() % 3 != 0)
+						continue;
+
+					trigonometry::geometric::optimize_vertex_cache(mesh.indices, mesh.vertices.size());
+					trigonometry::geometric::optimize_vertex_fetch(mesh.vertices, mesh.indices);
+				}
 				return info;
 #else
 				return content_exception("import model: unsupported");
@@ -1492,6 +1615,56 @@ namespace vitex
 				asset->resource = nullptr;
 				core::memory::release(value);
 			}
+			expects_content<void> model_processor::create_levels(model* object, size_t index, const graphics::mesh_buffer::desc& source)
+			{
+				VI_PROFILE("model_processor::create_levels");
+				if (!levels.count || source.indices.size() < levels.min_triangles * 3)
+					return core::expectation::met;
+
+				if (object->levels.empty())
+				{
+					object->levels.resize(levels.count);
+					float size = levels.size;
+					for (auto& level : object->levels)
+					{
+						level.size = size;
+						size *= levels.falloff;
+					}
+				}
+
+				auto* base = object->meshes[index];
+				auto* heavy_content = (heavy_content_manager*)content;
+				auto* device = heavy_content->get_device();
+				size_t previous_count = source.indices.size();
+				float reduction = 1.0f;
+				for (size_t i = 0; i < object->levels.size(); i++)
+				{
+					auto& level = object->levels[i];
+					if (level.meshes.size() < object->meshes.size())
+						level.meshes.resize(object->meshes.size(), nullptr);
+
+					reduction *= levels.reduction;
+					size_t target_count = (size_t)((float)source.indices.size() * reduction) / 3 * 3;
+					float error = 0.0f;
+
+					graphics::mesh_buffer::desc next;
+					if (!simplify_mesh(source, next, target_count, previous_count, levels.error * (float)(i + 1), &error))
+						break;
+
+					auto new_buffer = process_renderer_job<graphics::expects_graphics<graphics::mesh_buffer*>>(device, [&next](graphics::graphics_device* device) { return device->create_mesh_buffer(next); });
+					if (!new_buffer)
+						return content_exception(std::move(new_buffer.error().message()));
+
+					new_buffer->name = base->name;
+					new_buffer->transform = base->transform;
+					level.meshes[index] = *new_buffer;
+					level.error = std::max(level.error, error);
+					previous_count = next.indices.size();
+					VI_TRACE("[layer] model mesh %s lod %i simplified %i -> %i triangles", base->name.c_str(), (int)(i + 1), (int)(source.indices.size() / 3), (int)(next.indices.size() / 3));
+				}
+
+				return core::expectation::met;
+			}
 
 			skin_model_processor::skin_model_processor(content_manager* manager) : processor(manager)
 			{
@@ -1509,6 +1682,7 @@ namespace vitex
 			}
 			expects_content<void*> skin_model_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("skin_model_processor::deserialize");
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				core::uptr<skin_model> object = new skin_model();
 				auto path = stream->virtual_name();
@@ -1619,6 +1793,7 @@ namespace vitex
 			}
 			expects_content<void*> skin_animation_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("skin_animation_processor::deserialize");
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				core::vector<trigonometry::skin_animator_clip> clips;
 				auto path = stream->virtual_name();
@@ -1754,6 +1929,32 @@ namespace vitex
 				core::memory::release(value);
 			}
 
+			scene_snapshot_processor::scene_snapshot_processor(content_manager* manager) : processor(manager)
+			{
+			}
+			scene_snapshot_processor::~scene_snapshot_processor()
+			{
+			}
+			expects_content<void*> scene_snapshot_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
+			{
+				VI_PROFILE("scene_snapshot_processor::deserialize");
+				VI_ASSERT(stream != nullptr, "stream should be set");
+				core::string data;
+				stream->read_all([&data](uint8_t* buffer, size_t size) { data.append((char*)buffer, size); });
+
+				core::uptr<scene_snapshot> object = new scene_snapshot();
+				if (!object->load(data))
+					return content_exception("import snapshot: invalid format");
+
+				return object.reset();
+			}
+			void scene_snapshot_processor::free(asset_cache* asset)
+			{
+				VI_ASSERT(asset != nullptr, "asset should be set");
+				auto* value = (scene_snapshot*)asset->resource;
+				asset->resource = nullptr;
+				core::memory::release(value);
+			}
 			hull_shape_processor::hull_shape_processor(content_manager* manager) : processor(manager)
 			{
 			}
@@ -1770,6 +1971,7 @@ namespace vitex
 			}
 			expects_content<void*> hull_shape_processor::deserialize(core::stream* stream, size_t offset, const core::variant_args& args)
 			{
+				VI_PROFILE("hull_shape_processor::deserialize");
 				VI_ASSERT(stream != nullptr, "stream should be set");
 				auto data_status = content->load<core::schema>(stream->virtual_name());
 				if (!data_status)
@@ -107,6 +107,16 @@ namespace vitex
 
 			class scene_graph_processor final : public processor
 			{
+			private:
+				struct material_request
+				{
+					core::string path;
+					core::string error;
+					core::schema* node = nullptr;
+					layer::material* value = nullptr;
+					size_t origin = 0;
+				};
+
 			public:
 				std::function<void(scene_graph*)> setup_callback;
 
@@ -153,6 +163,16 @@ namespace vitex
 			public:
 				graphics::mesh_buffer::desc options;
 
+				struct
+				{
+					size_t count = 3;
+					size_t min_triangles = 256;
+					float reduction = 0.5f;
+					float error = 0.01f;
+					float size = 0.25f;
+					float falloff = 0.4f;
+				} levels;
+
 			public:
 				model_processor(content_manager* manager);
 				~model_processor() override;
@@ -163,6 +183,9 @@ namespace vitex
 			public:
 				static expects_content<core::schema*> import(core::stream * stream, uint64_t opts = (uint64_t)mesh_preset::defaults);
 				static expects_content<model_info> import_for_immediate_use(core::stream* stream, uint64_t opts = (uint64_t)mesh_preset::defaults);
+
+			private:
+				expects_content<void> create_levels(model* object, size_t index, const graphics::mesh_buffer::desc& source);
 			};
 
 			class skin_model_processor final : public processor
@@ -192,6 +215,15 @@ namespace vitex
 				static expects_content<core::vector<trigonometry::skin_animator_clip>> import_for_immediate_use(core::stream* stream, uint64_t opts = (uint64_t)mesh_preset::defaults);
 			};
 
+			class scene_snapshot_processor final : public processor
+			{
+			public:
+				scene_snapshot_processor(content_manager* manager);
+				~scene_snapshot_processor() override;
+				expects_content<void*> deserialize(core::stream* stream, size_t offset, const core::variant_args& args) override;
+				void free(asset_cache* asset) override;
+			};
+
 			class hull_shape_processor final : public processor
 			{
 			public:
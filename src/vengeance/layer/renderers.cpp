@@ -7,7 +7,7 @@ namespace vitex
 	{
 		namespace renderers
 		{
-			soft_body::soft_body(layer::render_system* lab) : geometry_renderer(lab), vertex_buffer(nullptr), index_buffer(nullptr)
+			soft_body::soft_body(layer::render_system* lab) : geometry_renderer(lab)
 			{
 				VI_ASSERT(system != nullptr, "render system should be set");
 				VI_ASSERT(system->get_device() != nullptr, "graphics device should be set");
@@ -44,13 +44,6 @@ namespace vitex
 				pipelines.geometry.materials = *device->get_shader_slot(pipelines.geometry.shader, "Materials");
 				pipelines.geometry.viewer_buffer = *device->get_shader_slot(pipelines.geometry.shader, "ViewerBuffer");
 
-				graphics::element_buffer* buffers[2];
-				if (lab->compile_buffers(buffers, "soft-body", sizeof(trigonometry::vertex), 16384))
-				{
-					index_buffer = buffers[(size_t)buffer_type::index];
-					vertex_buffer = buffers[(size_t)buffer_type::vertex];
-				}
-
 				graphics::element_buffer::desc desc = graphics::element_buffer::desc();
 				desc.access_flags = graphics::cpu_access::write;
 				desc.usage = graphics::resource_usage::dynamic;
@@ -62,17 +55,28 @@ namespace vitex
 			}
 			soft_body::~soft_body()
 			{
-				graphics::element_buffer* buffers[2];
-				buffers[(size_t)buffer_type::index] = index_buffer;
-				buffers[(size_t)buffer_type::vertex] = vertex_buffer;
+				core::memory::release(streaming.vertex_buffer);
+				core::memory::release(streaming.index_buffer);
 				core::memory::release(group_buffer);
 
-				system->free_buffers(buffers);
 				system->free_shader(pipelines.geometry.shader);
 				system->free_shader(pipelines.culling.shader);
 				system->free_shader(pipelines.depth.shader);
 				system->free_shader(pipelines.depth_cube.shader);
 			}
+			void soft_body::begin_pass(core::timer* time)
+			{
+				size_t frame = (size_t)time->get_frame_index();
+				if (streaming.frame != frame)
+				{
+					VI_PROFILE("soft_body_renderer::stream");
+					streaming.frame = frame;
+					pack_stream();
+					update_stream();
+				}
+
+				geometry_renderer::begin_pass(time);
+			}
 			size_t soft_body::cull_geometry(const viewer& view, const geometry_renderer::objects& chunk)
 			{
 				VI_ASSERT(system->get_primitives() != nullptr, "primitives cache should be set");
@@ -90,18 +94,18 @@ namespace vitex
 				size_t count = 0;
 				if (system->precise_culling)
 				{
+					device->set_vertex_buffer(streaming.vertex_buffer);
+					device->set_index_buffer(streaming.index_buffer, graphics::format::r32_uint);
+					system->constants->render.world.identify();
+					system->constants->render.transform = view.view_projection;
+					system->update_constant_buffer(render_buffer_type::render);
+
 					for (auto* base : chunk)
 					{
-						if (base->get_indices().empty() || !culling_begin(base))
+						if (!is_streamed(base) || !culling_begin(base))
 							continue;
 
-						base->fill(device, index_buffer, vertex_buffer);
-						system->constants->render.world.identify();
-						system->constants->render.transform = view.view_projection;
-						system->update_constant_buffer(render_buffer_type::render);
-						device->set_vertex_buffer(vertex_buffer);
-						device->set_index_buffer(index_buffer, graphics::format::r32_uint);
-						device->draw_indexed((uint32_t)base->get_indices().size(), 0, 0);
+						device->draw_indexed(base->streaming.index_count, base->streaming.index_offset, base->streaming.vertex_offset);
 						culling_end();
 						count++;
 					}
@@ -144,14 +148,15 @@ namespace vitex
 				device->set_shader(pipelines.geometry.shader, VI_VS | VI_PS);
 
 				graphics::element_buffer* group_vertex_buffers[2];
-				group_vertex_buffers[0] = vertex_buffer;
+				group_vertex_buffers[0] = streaming.vertex_buffer;
 				group_vertex_buffers[1] = group_buffer;
 				device->set_vertex_buffers(group_vertex_buffers, sizeof(group_vertex_buffers) / sizeof(*group_vertex_buffers));
+				device->set_index_buffer(streaming.index_buffer, graphics::format::r32_uint);
 
 				size_t count = 0;
 				for (auto* base : chunk)
 				{
-					if ((constant && !base->constant) || base->get_indices().empty())
+					if ((constant && !base->constant) || !is_streamed(base))
 						continue;
 
 					if (!system->try_geometry(base->get_material(), &pipelines.geometry.slotdata))
@@ -160,10 +165,8 @@ namespace vitex
 					group.world.identify();
 					group.transform = system->view.view_projection;
 					group.texcoord = base->texcoord;
-					base->fill(device, index_buffer, vertex_buffer);
 					device->update_buffer(group_buffer, &group, sizeof(group));
-					device->set_index_buffer(index_buffer, graphics::format::r32_uint);
-					device->draw_indexed_instanced((uint32_t)base->get_indices().size(), 1, 0, 0, 0);
+					device->draw_indexed_instanced(base->streaming.index_count, 1, base->streaming.index_offset, base->streaming.vertex_offset, 0);
 					count++;
 				}
 
@@ -184,14 +187,15 @@ namespace vitex
 				device->set_shader(pipelines.depth.shader, VI_VS | VI_PS);
 
 				graphics::element_buffer* group_vertex_buffers[2];
-				group_vertex_buffers[0] = vertex_buffer;
+				group_vertex_buffers[0] = streaming.vertex_buffer;
 				group_vertex_buffers[1] = group_buffer;
 				device->set_vertex_buffers(group_vertex_buffers, sizeof(group_vertex_buffers) / sizeof(*group_vertex_buffers));
+				device->set_index_buffer(streaming.index_buffer, graphics::format::r32_uint);
 
 				size_t count = 0;
 				for (auto* base : chunk)
 				{
-					if (base->get_indices().empty())
+					if (!is_streamed(base))
 						continue;
 
 					if (!system->try_geometry(base->get_material(), &pipelines.depth.slotdata))
@@ -200,10 +204,8 @@ namespace vitex
 					group.world.identify();
 					group.transform = system->view.view_projection;
 					group.texcoord = base->texcoord;
-					base->fill(device, index_buffer, vertex_buffer);
 					device->update_buffer(group_buffer, &group, sizeof(group));
-					device->set_index_buffer(index_buffer, graphics::format::r32_uint);
-					device->draw_indexed_instanced((uint32_t)base->get_indices().size(), 1, 0, 0, 0);
+					device->draw_indexed_instanced(base->streaming.index_count, 1, base->streaming.index_offset, base->streaming.vertex_offset, 0);
 
 					count++;
 				}
@@ -228,14 +230,15 @@ namespace vitex
 				device->update_buffer(pipelines.depth_cube.shader, view_projection);
 
 				graphics::element_buffer* group_vertex_buffers[2];
-				group_vertex_buffers[0] = vertex_buffer;
+				group_vertex_buffers[0] = streaming.vertex_buffer;
 				group_vertex_buffers[1] = group_buffer;
 				device->set_vertex_buffers(group_vertex_buffers, sizeof(group_vertex_buffers) / sizeof(*group_vertex_buffers));
+				device->set_index_buffer(streaming.index_buffer, graphics::format::r32_uint);
 
 				size_t count = 0;
 				for (auto* base : chunk)
 				{
-					if (!base->get_body())
+					if (!is_streamed(base))
 						continue;
 
 					if (!system->try_geometry(base->get_material(), &pipelines.depth_cube.slotdata))
@@ -243,10 +246,8 @@ namespace vitex
 
 					group.world.identify();
 					group.texcoord = base->texcoord;
-					base->fill(device, index_buffer, vertex_buffer);
 					device->update_buffer(group_buffer, &group, sizeof(group));
-					device->set_index_buffer(index_buffer, graphics::format::r32_uint);
-					device->draw_indexed_instanced((uint32_t)base->get_indices().size(), 1, 0, 0, 0);
+					device->draw_indexed_instanced(base->streaming.index_count, 1, base->streaming.index_offset, base->streaming.vertex_offset, 0);
 
 					count++;
 				}
@@ -256,6 +257,89 @@ namespace vitex
 				device->set_shader(nullptr, VI_GS);
 				return count;
 			}
+			size_t soft_body::pack_stream()
+			{
+				VI_ASSERT(system->get_scene() != nullptr, "scene should be set");
+				auto& bodies = system->get_scene()->get_components<components::soft_body>();
+				size_t vertices_count = 0, indices_count = 0;
+				streaming.queue.clear();
+
+				for (auto it = bodies.begin(); it != bodies.end(); ++it)
+				{
+					auto* base = (components::soft_body*)*it;
+					auto& vertices = base->get_vertices();
+					auto& indices = base->get_indices();
+					if (!base->is_active() || vertices.empty() || indices.empty())
+						continue;
+
+					base->streaming.frame = streaming.frame;
+					base->streaming.vertex_offset = (uint32_t)vertices_count;
+					base->streaming.index_offset = (uint32_t)indices_count;
+					base->streaming.index_count = (uint32_t)indices.size();
+					vertices_count += vertices.size();
+					indices_count += indices.size();
+					streaming.queue.push_back(base);
+				}
+
+				streaming.vertices.resize(vertices_count);
+				streaming.indices.resize(indices_count);
+				parallel::wail_all(parallel::for_each(streaming.queue.begin(), streaming.queue.end(), THRESHOLD_PER_THREAD, [this](components::soft_body* base)
+				{
+					auto& vertices = base->get_vertices();
+					auto& indices = base->get_indices();
+					memcpy(streaming.vertices.data() + base->streaming.vertex_offset, vertices.data(), sizeof(trigonometry::vertex) * vertices.size());
+					memcpy(streaming.indices.data() + base->streaming.index_offset, indices.data(), sizeof(int) * indices.size());
+				}));
+
+				return streaming.queue.size();
+			}
+			bool soft_body::update_stream()
+			{
+				graphics::graphics_device* device = system->get_device();
+				size_t vertices_count = streaming.vertices.size();
+				if (!streaming.vertex_buffer || (size_t)streaming.vertex_buffer->get_elements() < vertices_count)
+				{
+					graphics::element_buffer::desc f = graphics::element_buffer::desc();
+					f.access_flags = graphics::cpu_access::write;
+					f.usage = graphics::resource_usage::dynamic;
+					f.bind_flags = graphics::resource_bind::vertex_buffer;
+					f.element_width = sizeof(trigonometry::vertex);
+					f.element_count = (uint32_t)std::max<size_t>(vertices_count + vertices_count / 2, 16384);
+
+					core::memory::release(streaming.vertex_buffer);
+					streaming.vertex_buffer = device->create_element_buffer(f).or_else(nullptr);
+					if (!streaming.vertex_buffer)
+						return false;
+				}
+
+				size_t indices_count = streaming.indices.size();
+				if (!streaming.index_buffer || (size_t)streaming.index_buffer->get_elements() < indices_count)
+				{
+					graphics::element_buffer::desc f = graphics::element_buffer::desc();
+					f.access_flags = graphics::cpu_access::write;
+					f.usage = graphics::resource_usage::dynamic;
+					f.bind_flags = graphics::resource_bind::index_buffer;
+					f.element_width = sizeof(int);
+					f.element_count = (uint32_t)std::max<size_t>(indices_count + indices_count / 2, 16384 * 3);
+
+					core::memory::release(streaming.index_buffer);
+					streaming.index_buffer = device->create_element_buffer(f).or_else(nullptr);
+					if (!streaming.index_buffer)
+						return false;
+				}
+
+				if (vertices_count > 0 && !device->update_buffer(streaming.vertex_buffer, streaming.vertices.data(), sizeof(trigonometry::vertex) * vertices_count))
+					return false;
+
+				if (indices_count > 0 && !device->update_buffer(streaming.index_buffer, streaming.indices.data(), sizeof(int) * indices_count))
+					return false;
+
+				return true;
+			}
+			bool soft_body::is_streamed(components::soft_body* base) const
+			{
+				return streaming.vertex_buffer != nullptr && streaming.index_buffer != nullptr && base->streaming.frame == streaming.frame && base->streaming.index_count > 0;
+			}
 
 			model::model(layer::render_system* lab) : geometry_renderer(lab)
 			{
@@ -302,6 +386,22 @@ namespace vitex
 				system->free_shader(pipelines.depth.shader);
 				system->free_shader(pipelines.depth_cube.shader);
 			}
+			void model::deserialize(core::schema* node)
+			{
+				VI_ASSERT(node != nullptr, "schema should be set");
+				series::unpack(node->find("lod-enabled"), &levels.enabled);
+				series::unpack(node->find("lod-bias"), &levels.bias);
+				series::unpack(node->find("lod-depth-bias"), &levels.depth_bias);
+				series::unpack(node->find("lod-hysteresis"), &levels.hysteresis);
+			}
+			void model::serialize(core::schema* node)
+			{
+				VI_ASSERT(node != nullptr, "schema should be set");
+				series::pack(node->set("lod-enabled"), levels.enabled);
+				series::pack(node->set("lod-bias"), levels.bias);
+				series::pack(node->set("lod-depth-bias"), levels.depth_bias);
+				series::pack(node->set("lod-hysteresis"), levels.hysteresis);
+			}
 			void model::batch_geometry(components::model* base, geometry_renderer::batching& batch, size_t chunk)
 			{
 				auto* drawable = get_drawable(base);
@@ -311,15 +411,17 @@ namespace vitex
 				render_buffer::instance data;
 				data.texcoord = base->texcoord;
 
+				size_t level = get_level(base, drawable, system->view);
 				auto& world = base->get_entity()->get_box();
-				for (auto* mesh : drawable->meshes)
+				for (size_t i = 0; i < drawable->meshes.size(); i++)
 				{
+					auto* mesh = drawable->meshes[i];
 					material* source = base->get_material(mesh);
 					if (system->try_instance(source, data))
 					{
 						data.world = mesh->transform * world;
 						data.transform = data.world * system->view.view_projection;
-						batch.emplace(mesh, source, data, chunk);
+						batch.emplace(level > 0 ? drawable->get_level_mesh(i, level) : mesh, source, data, chunk);
 					}
 				}
 			}
@@ -347,12 +449,14 @@ namespace vitex
 
 						auto* drawable = get_drawable(base);
 						auto& world = base->get_entity()->get_box();
-						for (auto* mesh : drawable->meshes)
+						size_t level = get_level(base, drawable, view);
+						for (size_t i = 0; i < drawable->meshes.size(); i++)
 						{
+							auto* mesh = drawable->meshes[i];
 							system->constants->render.world = mesh->transform * world;
 							system->constants->render.transform = system->constants->render.world * view.view_projection;
 							system->update_constant_buffer(render_buffer_type::render);
-							device->draw_indexed(mesh);
+							device->draw_indexed(level > 0 ? drawable->get_level_mesh(i, level) : mesh);
 						}
 
 						culling_end();
@@ -395,7 +499,7 @@ namespace vitex
 				for (auto& group : chunk)
 				{
 					if (system->try_geometry(group->material_data, &pipelines.geometry.slotdata))
-						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, (uint32_t)group->instances.size());
+						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, group->instance_count, group->instance_location);
 				}
 
 				static graphics::element_buffer* vertex_buffers[2] = { nullptr, nullptr };
@@ -417,7 +521,7 @@ namespace vitex
 				for (auto& group : chunk)
 				{
 					if (system->try_geometry(group->material_data, &pipelines.depth.slotdata))
-						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, (uint32_t)group->instances.size());
+						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, group->instance_count, group->instance_location);
 				}
 
 				static graphics::element_buffer* vertex_buffers[2] = { nullptr, nullptr };
@@ -442,7 +546,7 @@ namespace vitex
 				for (auto& group : chunk)
 				{
 					if (system->try_geometry(group->material_data, &pipelines.depth_cube.slotdata))
-						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, (uint32_t)group->instances.size());
+						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, group->instance_count, group->instance_location);
 				}
 
 				static graphics::element_buffer* vertex_buffers[2] = { nullptr, nullptr };
@@ -458,6 +562,22 @@ namespace vitex
 
 				return drawable;
 			}
+			size_t model::get_level(components::model* base, layer::model* drawable, const viewer& view)
+			{
+				if (!levels.enabled || drawable->levels.empty())
+					return 0;
+
+				auto* entity = base->get_entity();
+				float size = entity->get_radius() * view.projection.row[5] * levels.bias;
+				if (view.projection.row[15] == 0.0f)
+					size /= std::max(entity->get_transform()->get_position().distance(view.position), std::max(view.near_plane, 0.0001f));
+
+				if (!system->state.is(render_state::geometry))
+					return drawable->get_level(size * levels.depth_bias, base->level, 0.0f);
+
+				base->level = drawable->get_level(size, base->level, levels.hysteresis);
+				return base->level;
+			}
 
 			skin::skin(layer::render_system* lab) : geometry_renderer(lab)
 			{
@@ -470,23 +590,23 @@ namespace vitex
 				front_rasterizer = device->get_rasterizer_state("so_cfront");
 				blend = device->get_blend_state("bo_wrgba_one");
 				sampler = device->get_sampler_state("a16_fa_wrap");
-				layout = device->get_input_layout("vx_skin");
+				layout[0] = device->get_input_layout("vx_skin");
+				layout[1] = device->get_input_layout("vxi_skin");
 
 				pipelines.culling.shader = *system->compile_shader("materials/material_skin_culling", { });
+				pipelines.culling.palette = *device->get_shader_slot(pipelines.culling.shader, "JointPalette");
 				pipelines.culling.animation_buffer = *device->get_shader_slot(pipelines.culling.shader, "AnimationBuffer");
 				pipelines.culling.object_buffer = *device->get_shader_slot(pipelines.culling.shader, "ObjectBuffer");
 				pipelines.depth.shader = *system->compile_shader("materials/material_skin_depth", { });
 				pipelines.depth.slotdata.diffuse_map = *device->get_shader_slot(pipelines.depth.shader, "DiffuseMap");
 				pipelines.depth.sampler = *device->get_shader_sampler_slot(pipelines.depth.shader, "DiffuseMap", "Sampler");
 				pipelines.depth.materials = *device->get_shader_slot(pipelines.depth.shader, "Materials");
-				pipelines.depth.animation_buffer = *device->get_shader_slot(pipelines.depth.shader, "AnimationBuffer");
-				pipelines.depth.object_buffer = *device->get_shader_slot(pipelines.depth.shader, "ObjectBuffer");
+				pipelines.depth.palette = *device->get_shader_slot(pipelines.depth.shader, "JointPalette");
 				pipelines.depth_cube.shader = *system->compile_shader("materials/material_skin_depth_cube", { }, sizeof(trigonometry::matrix4x4) * 6);
 				pipelines.depth_cube.slotdata.diffuse_map = *device->get_shader_slot(pipelines.depth_cube.shader, "DiffuseMap");
 				pipelines.depth_cube.sampler = *device->get_shader_sampler_slot(pipelines.depth_cube.shader, "DiffuseMap", "Sampler");
 				pipelines.depth_cube.materials = *device->get_shader_slot(pipelines.depth_cube.shader, "Materials");
-				pipelines.depth_cube.animation_buffer = *device->get_shader_slot(pipelines.depth_cube.shader, "AnimationBuffer");
-				pipelines.depth_cube.object_buffer = *device->get_shader_slot(pipelines.depth_cube.shader, "ObjectBuffer");
+				pipelines.depth_cube.palette = *device->get_shader_slot(pipelines.depth_cube.shader, "JointPalette");
 				pipelines.depth_cube.viewer_buffer = *device->get_shader_slot(pipelines.depth_cube.shader, "ViewerBuffer");
 				pipelines.depth_cube.cube_buffer = *device->get_shader_slot(pipelines.depth_cube.shader, "CubeBuffer");
 				pipelines.geometry.shader = *system->compile_shader("materials/material_skin_geometry", { });
@@ -499,8 +619,7 @@ namespace vitex
 				pipelines.geometry.slotdata.emission_map = *device->get_shader_slot(pipelines.geometry.shader, "EmissionMap");
 				pipelines.geometry.sampler = *device->get_shader_sampler_slot(pipelines.geometry.shader, "DiffuseMap", "Sampler");
 				pipelines.geometry.materials = *device->get_shader_slot(pipelines.geometry.shader, "Materials");
-				pipelines.geometry.animation_buffer = *device->get_shader_slot(pipelines.geometry.shader, "AnimationBuffer");
-				pipelines.geometry.object_buffer = *device->get_shader_slot(pipelines.geometry.shader, "ObjectBuffer");
+				pipelines.geometry.palette = *device->get_shader_slot(pipelines.geometry.shader, "JointPalette");
 				pipelines.geometry.viewer_buffer = *device->get_shader_slot(pipelines.geometry.shader, "ViewerBuffer");
 			}
 			skin::~skin()
@@ -509,6 +628,55 @@ namespace vitex
 				system->free_shader(pipelines.culling.shader);
 				system->free_shader(pipelines.depth.shader);
 				system->free_shader(pipelines.depth_cube.shader);
+				core::memory::release(palette.buffer);
+			}
+			void skin::begin_pass(core::timer* time)
+			{
+				size_t frame = (size_t)time->get_frame_index();
+				if (palette.frame != frame)
+				{
+					VI_PROFILE("skin_renderer::palette");
+					palette.frame = frame;
+					pack_palette();
+					update_palette();
+				}
+
+				geometry_renderer::begin_pass(time);
+			}
+			void skin::batch_geometry(components::skin* base, geometry_renderer::batching& batch, size_t chunk)
+			{
+				if (!base->constant && system->state.is_set(render_opt::constant))
+					return;
+
+				auto* drawable = get_drawable(base);
+				bool animated = !drawable->skeleton.childs.empty();
+
+				render_buffer::skin_instance data;
+				data.texcoord = base->texcoord;
+
+				auto& world = base->get_entity()->get_box();
+				for (auto* mesh : drawable->meshes)
+				{
+					material* source = base->get_material(mesh);
+					if (!system->try_instance(source, data))
+						continue;
+
+					auto matrices = base->skeleton.matrices.find(mesh);
+					if (animated && matrices != base->skeleton.matrices.end())
+					{
+						data.offset = (float)matrices->second.palette;
+						data.animated = 1.0f;
+					}
+					else
+					{
+						data.offset = 0.0f;
+						data.animated = 0.0f;
+					}
+
+					data.world = mesh->transform * world;
+					data.transform = data.world * system->view.view_projection;
+					batch.emplace(mesh, source, data, chunk);
+				}
 			}
 			size_t skin::cull_geometry(const viewer& view, const geometry_renderer::objects& chunk)
 			{
@@ -520,8 +688,9 @@ namespace vitex
 				graphics::graphics_device* device = system->get_device();
 				system->set_constant_buffer(render_buffer_type::animation, pipelines.culling.animation_buffer, VI_VS);
 				system->set_constant_buffer(render_buffer_type::render, pipelines.culling.object_buffer, VI_VS);
+				device->set_structure_buffer(palette.buffer, pipelines.culling.palette, VI_VS);
 				device->set_rasterizer_state(back_rasterizer);
-				device->set_input_layout(layout);
+				device->set_input_layout(layout[0]);
 				device->set_shader(nullptr, VI_PS);
 				device->set_shader(pipelines.culling.shader, VI_VS);
 
@@ -535,12 +704,14 @@ namespace vitex
 
 						auto* drawable = get_drawable(base);
 						auto& world = base->get_entity()->get_box();
-						system->constants->animation.animated = (float)!drawable->skeleton.childs.empty();
+						bool animated = !drawable->skeleton.childs.empty() && palette.buffer != nullptr;
 
 						for (auto* mesh : drawable->meshes)
 						{
-							auto& matrices = base->skeleton.matrices[mesh];
-							memcpy(system->constants->animation.offsets, matrices.data, sizeof(matrices.data));
+							auto matrices = base->skeleton.matrices.find(mesh);
+							bool skinned = animated && matrices != base->skeleton.matrices.end();
+							system->constants->animation.offset = skinned ? (float)matrices->second.palette : 0.0f;
+							system->constants->animation.animated = (float)skinned;
 							system->constants->render.world = mesh->transform * world;
 							system->constants->render.transform = system->constants->render.world * view.view_projection;
 							system->update_constant_buffer(render_buffer_type::animation);
@@ -556,15 +727,16 @@ namespace vitex
 				{
 					device->set_vertex_buffer(box[(size_t)buffer_type::vertex]);
 					device->set_index_buffer(box[(size_t)buffer_type::index], graphics::format::r32_uint);
+					system->constants->animation.offset = 0.0f;
+					system->constants->animation.animated = (float)false;
+					system->update_constant_buffer(render_buffer_type::animation);
 					for (auto* base : chunk)
 					{
 						if (!culling_begin(base))
 							continue;
 
-						system->constants->animation.animated = (float)false;
 						system->constants->render.world = base->get_entity()->get_box();
 						system->constants->render.transform = system->constants->render.world * view.view_projection;
-						system->update_constant_buffer(render_buffer_type::animation);
 						system->update_constant_buffer(render_buffer_type::render);
 						device->draw_indexed((uint32_t)box[(size_t)buffer_type::index]->get_elements(), 0, 0);
 						culling_end();
@@ -574,135 +746,132 @@ namespace vitex
 
 				return count;
 			}
-			size_t skin::render_geometry(core::timer* time, const geometry_renderer::objects& chunk)
+			size_t skin::render_geometry_batched(core::timer* time, const geometry_renderer::groups& chunk)
 			{
 				VI_ASSERT(system->get_scene() != nullptr, "scene should be set");
 				graphics::graphics_device* device = system->get_device();
-				bool constant = system->state.is_set(render_opt::constant);
-
-				system->set_constant_buffer(render_buffer_type::animation, pipelines.geometry.animation_buffer, VI_VS);
-				system->set_constant_buffer(render_buffer_type::render, pipelines.geometry.object_buffer, VI_VS | VI_PS);
 				system->set_constant_buffer(render_buffer_type::view, pipelines.geometry.viewer_buffer, VI_VS | VI_PS);
 				device->set_structure_buffer(system->get_material_buffer(), pipelines.geometry.materials, VI_PS);
+				device->set_structure_buffer(palette.buffer, pipelines.geometry.palette, VI_VS);
 				device->set_depth_stencil_state(depth_stencil);
 				device->set_blend_state(blend);
 				device->set_rasterizer_state(back_rasterizer);
-				device->set_input_layout(layout);
+				device->set_input_layout(layout[1]);
 				device->set_sampler_state(sampler, pipelines.geometry.sampler, 7, VI_PS);
 				device->set_shader(pipelines.geometry.shader, VI_VS | VI_PS);
 
-				size_t count = 0;
-				for (auto* base : chunk)
+				for (auto& group : chunk)
 				{
-					if (constant && !base->constant)
-						continue;
-
-					auto* drawable = get_drawable(base);
-					auto& world = base->get_entity()->get_box();
-					system->constants->animation.animated = (float)!drawable->skeleton.childs.empty();
-					system->constants->render.texcoord = base->texcoord;
-
-					for (auto* mesh : drawable->meshes)
-					{
-						if (!system->try_geometry(base->get_material(mesh), &pipelines.geometry.slotdata))
-							continue;
-
-						auto& matrices = base->skeleton.matrices[mesh];
-						memcpy(system->constants->animation.offsets, matrices.data, sizeof(matrices.data));
-						system->constants->render.world = mesh->transform * world;
-						system->constants->render.transform = system->constants->render.world * system->view.view_projection;
-						system->update_constant_buffer(render_buffer_type::animation);
-						system->update_constant_buffer(render_buffer_type::render);
-						device->draw_indexed(mesh);
-					}
-					count++;
+					if (system->try_geometry(group->material_data, &pipelines.geometry.slotdata))
+						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, group->instance_count, group->instance_location);
 				}
 
-				return count;
+				static graphics::element_buffer* vertex_buffers[2] = { nullptr, nullptr };
+				device->set_vertex_buffers(vertex_buffers, sizeof(vertex_buffers) / sizeof(*vertex_buffers));
+				return chunk.size();
 			}
-			size_t skin::render_depth(core::timer* time, const geometry_renderer::objects& chunk)
+			size_t skin::render_depth_batched(core::timer* time, const geometry_renderer::groups& chunk)
 			{
 				VI_ASSERT(system->get_scene() != nullptr, "scene should be set");
 				graphics::graphics_device* device = system->get_device();
-				system->set_constant_buffer(render_buffer_type::animation, pipelines.depth.animation_buffer, VI_VS);
-				system->set_constant_buffer(render_buffer_type::render, pipelines.depth.object_buffer, VI_VS | VI_PS);
 				device->set_structure_buffer(system->get_material_buffer(), pipelines.depth.materials, VI_PS);
+				device->set_structure_buffer(palette.buffer, pipelines.depth.palette, VI_VS);
 				device->set_depth_stencil_state(depth_stencil);
 				device->set_blend_state(blend);
 				device->set_rasterizer_state(system->state.is_set(render_opt::backfaces) ? front_rasterizer : back_rasterizer);
-				device->set_input_layout(layout);
+				device->set_input_layout(layout[1]);
 				device->set_sampler_state(sampler, pipelines.depth.sampler, 1, VI_PS);
 				device->set_shader(pipelines.depth.shader, VI_VS | VI_PS);
 
-				size_t count = 0;
-				for (auto* base : chunk)
+				for (auto& group : chunk)
 				{
-					auto* drawable = get_drawable(base);
-					auto& world = base->get_entity()->get_box();
-					system->constants->animation.animated = (float)!drawable->skeleton.childs.empty();
-					system->constants->render.texcoord = base->texcoord;
-
-					for (auto* mesh : drawable->meshes)
-					{
-						if (!system->try_geometry(base->get_material(mesh), &pipelines.depth.slotdata))
-							continue;
-
-						auto& matrices = base->skeleton.matrices[mesh];
-						memcpy(system->constants->animation.offsets, matrices.data, sizeof(matrices.data));
-						system->constants->render.world = mesh->transform * world;
-						system->constants->render.transform = system->constants->render.world * system->view.view_projection;
-						system->update_constant_buffer(render_buffer_type::animation);
-						system->update_constant_buffer(render_buffer_type::render);
-						device->draw_indexed(mesh);
-					}
-
-					count++;
+					if (system->try_geometry(group->material_data, &pipelines.depth.slotdata))
+						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, group->instance_count, group->instance_location);
 				}
 
-				return count;
+				static graphics::element_buffer* vertex_buffers[2] = { nullptr, nullptr };
+				device->set_vertex_buffers(vertex_buffers, sizeof(vertex_buffers) / sizeof(*vertex_buffers));
+				return chunk.size();
 			}
-			size_t skin::render_depth_cube(core::timer* time, const geometry_renderer::objects& chunk, trigonometry::matrix4x4* view_projection)
+			size_t skin::render_depth_cube_batched(core::timer* time, const geometry_renderer::groups& chunk, trigonometry::matrix4x4* view_projection)
 			{
 				VI_ASSERT(system->get_scene() != nullptr, "scene should be set");
 				graphics::graphics_device* device = system->get_device();
-				system->set_constant_buffer(render_buffer_type::animation, pipelines.depth_cube.animation_buffer, VI_VS);
-				system->set_constant_buffer(render_buffer_type::render, pipelines.depth_cube.object_buffer, VI_VS | VI_PS);
+				system->set_constant_buffer(render_buffer_type::view, pipelines.depth_cube.viewer_buffer, VI_VS | VI_PS | VI_GS);
 				device->set_structure_buffer(system->get_material_buffer(), pipelines.depth_cube.materials, VI_PS);
+				device->set_structure_buffer(palette.buffer, pipelines.depth_cube.palette, VI_VS);
 				device->set_depth_stencil_state(depth_stencil);
 				device->set_blend_state(blend);
 				device->set_rasterizer_state(system->state.is_set(render_opt::backfaces) ? front_rasterizer : back_rasterizer);
-				device->set_input_layout(layout);
-				device->set_sampler_state(sampler, pipelines.depth_cube.sampler, 7, VI_PS);
+				device->set_input_layout(layout[1]);
+				device->set_sampler_state(sampler, pipelines.depth_cube.sampler, 1, VI_PS);
 				device->set_shader(pipelines.depth_cube.shader, VI_VS | VI_PS | VI_GS);
 				device->set_buffer(pipelines.depth_cube.shader, pipelines.depth_cube.cube_buffer, VI_VS | VI_PS | VI_GS);
 				device->update_buffer(pipelines.depth_cube.shader, view_projection);
 
-				size_t count = 0;
-				for (auto* base : chunk)
+				for (auto& group : chunk)
 				{
-					auto* drawable = get_drawable(base);
-					auto& world = base->get_entity()->get_box();
-					system->constants->animation.animated = (float)!drawable->skeleton.childs.empty();
-					system->constants->render.texcoord = base->texcoord;
+					if (system->try_geometry(group->material_data, &pipelines.depth_cube.slotdata))
+						device->draw_indexed_instanced(group->data_buffer, group->geometry_buffer, group->instance_count, group->instance_location);
+				}
 
-					for (auto* mesh : drawable->meshes)
-					{
-						if (!system->try_geometry(base->get_material(mesh), &pipelines.depth_cube.slotdata))
-							continue;
+				static graphics::element_buffer* vertex_buffers[2] = { nullptr, nullptr };
+				device->set_vertex_buffers(vertex_buffers, sizeof(vertex_buffers) / sizeof(*vertex_buffers));
+				device->set_shader(nullptr, VI_GS);
+				return chunk.size();
+			}
+			size_t skin::pack_palette()
+			{
+				VI_ASSERT(system->get_scene() != nullptr, "scene should be set");
+				auto& skins = system->get_scene()->get_components<components::skin>();
+				palette.data.clear();
 
-						auto& matrices = base->skeleton.matrices[mesh];
-						memcpy(system->constants->animation.offsets, matrices.data, sizeof(matrices.data));
-						system->constants->render.world = mesh->transform * world;
-						system->update_constant_buffer(render_buffer_type::animation);
-						system->update_constant_buffer(render_buffer_type::render);
-						device->draw_indexed(mesh);
+				for (auto it = skins.begin(); it != skins.end(); ++it)
+				{
+					auto* base = (components::skin*)*it;
+					auto* drawable = base->get_drawable();
+					if (!base->is_active() || !drawable || drawable->skeleton.childs.empty())
+						continue;
+
+					for (auto& matrices : base->skeleton.matrices)
+					{
+						size_t count = std::min<size_t>(matrices.first->joints.size(), graphics::joints_size);
+						matrices.second.palette = (uint32_t)palette.data.size();
+						palette.data.insert(palette.data.end(), matrices.second.data, matrices.second.data + count);
 					}
+				}
 
-					count++;
+				return palette.data.size();
+			}
+			const core::vector<trigonometry::matrix4x4>& skin::get_palette() const
+			{
+				return palette.data;
+			}
+			bool skin::update_palette()
+			{
+				size_t elements_count = palette.data.size();
+				if (!palette.buffer || (size_t)palette.buffer->get_elements() < elements_count)
+				{
+					graphics::element_buffer::desc f = graphics::element_buffer::desc();
+					f.access_flags = graphics::cpu_access::write;
+					f.misc_flags = graphics::resource_misc::buffer_structured;
+					f.usage = graphics::resource_usage::dynamic;
+					f.bind_flags = graphics::resource_bind::shader_input;
+					f.element_count = (uint32_t)std::max<size_t>(elements_count + elements_count / 2, graphics::joints_size);
+					f.element_width = sizeof(trigonometry::matrix4x4);
+					f.structure_byte_stride = f.element_width;
+
+					core::memory::release(palette.buffer);
+					palette.buffer = system->get_device()->create_element_buffer(f).or_else(nullptr);
+					if (!palette.buffer)
+						return false;
 				}
 
-				device->set_shader(nullptr, VI_GS);
-				return count;
+				if (!elements_count)
+					return true;
+
+				auto status = system->get_device()->update_buffer(palette.buffer, palette.data.data(), sizeof(trigonometry::matrix4x4) * elements_count);
+				return !!status;
 			}
 			layer::skin_model* skin::get_drawable(components::skin* base)
 			{
@@ -1003,6 +1172,236 @@ namespace vitex
 				return count;
 			}
 
+			light_clusters::light_clusters(uint32_t new_width, uint32_t new_height, uint32_t new_depth) noexcept : slice_scale(0.0f), slice_bias(0.0f), near_plane(0.1f), far_plane(1.0f), width(0), height(0), depth(0)
+			{
+				resize(new_width, new_height, new_depth);
+			}
+			void light_clusters::resize(uint32_t new_width, uint32_t new_height, uint32_t new_depth)
+			{
+				new_width = std::max<uint32_t>(new_width, 1);
+				new_height = std::max<uint32_t>(new_height, 1);
+				new_depth = std::max<uint32_t>(new_depth, 1);
+				if (width == new_width && height == new_height && depth == new_depth)
+					return;
+
+				width = new_width;
+				height = new_height;
+				depth = new_depth;
+				cells.clear();
+				cells.resize((size_t)width * (size_t)height * (size_t)depth);
+				slices.resize(depth);
+				for (uint32_t i = 0; i < depth; i++)
+					slices[i].index = i;
+			}
+			void light_clusters::bin(const viewer& view, const core::vector<volume>& points, const core::vector<volume>& spots)
+			{
+				VI_MEASURE(core::timings::frame);
+				near_plane = std::max(view.near_plane, 0.001f);
+				far_plane = std::max(view.far_plane, near_plane + 0.001f);
+				slice_scale = (float)depth / std::log(far_plane / near_plane);
+				slice_bias = slice_scale * std::log(near_plane);
+				compute_extents(view, points, extents[0]);
+				compute_extents(view, spots, extents[1]);
+
+				parallel::wail_all(parallel::for_each(slices.begin(), slices.end(), THRESHOLD_PER_THREAD, [this](slice& next)
+				{
+					bin_slice(next);
+				}));
+
+				size_t total = 0;
+				for (auto& next : slices)
+					total += next.indices.size();
+
+				indices.resize(total);
+				total = 0;
+
+				size_t size = (size_t)width * (size_t)height;
+				for (auto& next : slices)
+				{
+					cell* base = cells.data() + size * next.index;
+					for (size_t i = 0; i < size; i++)
+						base[i].offset += (uint32_t)total;
+
+					if (!next.indices.empty())
+						memcpy(indices.data() + total, next.indices.data(), sizeof(uint32_t) * next.indices.size());
+					total += next.indices.size();
+				}
+			}
+			void light_clusters::clear()
+			{
+				for (auto& next : slices)
+					next.indices.clear();
+
+				for (auto& next : cells)
+					next = cell();
+
+				extents[0].clear();
+				extents[1].clear();
+				indices.clear();
+			}
+			void light_clusters::bin_slice(slice& next)
+			{
+				size_t size = (size_t)width * (size_t)height;
+				cell* base = cells.data() + size * next.index;
+				for (size_t i = 0; i < size; i++)
+					base[i] = cell();
+
+				for (auto& item : extents[0])
+				{
+					if (next.index < item.min_z || next.index > item.max_z)
+						continue;
+
+					for (uint32_t y = item.min_y; y <= item.max_y; y++)
+					{
+						for (uint32_t x = item.min_x; x <= item.max_x; x++)
+							++base[y * width + x].points;
+					}
+				}
+
+				for (auto& item : extents[1])
+				{
+					if (next.index < item.min_z || next.index > item.max_z)
+						continue;
+
+					for (uint32_t y = item.min_y; y <= item.max_y; y++)
+					{
+						for (uint32_t x = item.min_x; x <= item.max_x; x++)
+							++base[y * width + x].spots;
+					}
+				}
+
+				uint32_t offset = 0;
+				for (size_t i = 0; i < size; i++)
+				{
+					cell& target = base[i];
+					target.offset = offset;
+					offset += target.points + target.spots;
+				}
+
+				next.indices.resize(offset);
+				for (size_t i = 0; i < 2; i++)
+				{
+					auto& array = extents[i];
+					for (uint32_t j = 0; j < (uint32_t)array.size(); j++)
+					{
+						auto& item = array[j];
+						if (next.index < item.min_z || next.index > item.max_z)
+							continue;
+
+						for (uint32_t y = item.min_y; y <= item.max_y; y++)
+						{
+							for (uint32_t x = item.min_x; x <= item.max_x; x++)
+							{
+								cell& target = base[y * width + x];
+								next.indices[target.offset + target.padding++] = j;
+							}
+						}
+					}
+				}
+
+				for (size_t i = 0; i < size; i++)
+					base[i].padding = 0;
+			}
+			void light_clusters::compute_extents(const viewer& view, const core::vector<volume>& volumes, core::vector<extent>& output)
+			{
+				trigonometry::vector3 direction = view.rotation.ddirection();
+				output.resize(volumes.size());
+
+				for (size_t i = 0; i < volumes.size(); i++)
+				{
+					auto& item = volumes[i];
+					auto& result = output[i];
+					result = extent();
+
+					float distance = (item.position - view.position).dot(direction);
+					if (distance + item.radius < near_plane || distance - item.radius > far_plane)
+						continue;
+
+					trigonometry::vector2 lower(1.0f, 1.0f), upper(-1.0f, -1.0f);
+					bool inside = false;
+					for (size_t j = 0; j < 8; j++)
+					{
+						trigonometry::vector4 corner(
+							item.position.x + (j & 1 ? item.radius : -item.radius),
+							item.position.y + (j & 2 ? item.radius : -item.radius),
+							item.position.z + (j & 4 ? item.radius : -item.radius), 1.0f);
+						corner = corner.transform(view.view_projection);
+						if (corner.w <= near_plane)
+						{
+							inside = true;
+							break;
+						}
+
+						float x = corner.x / corner.w, y = corner.y / corner.w;
+						lower.x = std::min(lower.x, x);
+						lower.y = std::min(lower.y, y);
+						upper.x = std::max(upper.x, x);
+						upper.y = std::max(upper.y, y);
+					}
+
+					if (inside)
+					{
+						lower = trigonometry::vector2(-1.0f, -1.0f);
+						upper = trigonometry::vector2(1.0f, 1.0f);
+					}
+					else if (upper.x < -1.0f || upper.y < -1.0f || lower.x > 1.0f || lower.y > 1.0f)
+						continue;
+
+					result.min_x = (uint32_t)std::clamp((lower.x * 0.5f + 0.5f) * (float)width, 0.0f, (float)(width - 1));
+					result.max_x = (uint32_t)std::clamp((upper.x * 0.5f + 0.5f) * (float)width, 0.0f, (float)(width - 1));
+					result.min_y = (uint32_t)std::clamp((lower.y * 0.5f + 0.5f) * (float)height, 0.0f, (float)(height - 1));
+					result.max_y = (uint32_t)std::clamp((upper.y * 0.5f + 0.5f) * (float)height, 0.0f, (float)(height - 1));
+					result.min_z = get_slice(distance - item.radius);
+					result.max_z = get_slice(distance + item.radius);
+				}
+			}
+			const core::vector<light_clusters::cell>& light_clusters::get_cells() const
+			{
+				return cells;
+			}
+			const core::vector<uint32_t>& light_clusters::get_indices() const
+			{
+				return indices;
+			}
+			const light_clusters::cell& light_clusters::get_cell(uint32_t x, uint32_t y, uint32_t z) const
+			{
+				VI_ASSERT(x < width && y < height && z < depth, "cell should be within grid bounds");
+				return cells[((size_t)z * height + y) * width + x];
+			}
+			float light_clusters::get_slice_scale() const
+			{
+				return slice_scale;
+			}
+			float light_clusters::get_slice_bias() const
+			{
+				return slice_bias;
+			}
+			float light_clusters::get_near() const
+			{
+				return near_plane;
+			}
+			float light_clusters::get_far() const
+			{
+				return far_plane;
+			}
+			uint32_t light_clusters::get_width() const
+			{
+				return width;
+			}
+			uint32_t light_clusters::get_height() const
+			{
+				return height;
+			}
+			uint32_t light_clusters::get_depth() const
+			{
+				return depth;
+			}
+			uint32_t light_clusters::get_slice(float distance) const
+			{
+				distance = std::clamp(distance, near_plane, far_plane);
+				return (uint32_t)std::clamp(std::log(distance) * slice_scale - slice_bias, 0.0f, (float)(depth - 1));
+			}
+
 			lighting::lighting(render_system* lab) : renderer(lab)
 			{
 				VI_ASSERT(system != nullptr, "render system should be set");
@@ -1082,9 +1481,26 @@ namespace vitex
 				pipelines.surface.depth_buffer = *device->get_shader_slot(pipelines.surface.shader, "DepthBuffer");
 				pipelines.surface.surface_buffer = *device->get_shader_slot(pipelines.surface.shader, "SurfaceBuffer");
 				pipelines.surface.environment_map = *device->get_shader_slot(pipelines.surface.shader, "EnvironmentMap");
+				pipelines.clustered.shader = *system->compile_shader("shading/lighting_clustered", { }, sizeof(icluster_buffer));
+				pipelines.clustered.materials = *device->get_shader_slot(pipelines.clustered.shader, "Materials");
+				pipelines.clustered.sampler = *device->get_shader_sampler_slot(pipelines.clustered.shader, "DiffuseBuffer", "Sampler");
+				pipelines.clustered.viewer_buffer = *device->get_shader_slot(pipelines.clustered.shader, "ViewerBuffer");
+				pipelines.clustered.cluster_buffer = *device->get_shader_slot(pipelines.clustered.shader, "ClusterBuffer");
+				pipelines.clustered.diffuse_buffer = *device->get_shader_slot(pipelines.clustered.shader, "DiffuseBuffer");
+				pipelines.clustered.normal_buffer = *device->get_shader_slot(pipelines.clustered.shader, "NormalBuffer");
+				pipelines.clustered.depth_buffer = *device->get_shader_slot(pipelines.clustered.shader, "DepthBuffer");
+				pipelines.clustered.surface_buffer = *device->get_shader_slot(pipelines.clustered.shader, "SurfaceBuffer");
+				pipelines.clustered.point_lights = *device->get_shader_slot(pipelines.clustered.shader, "PointLights");
+				pipelines.clustered.spot_lights = *device->get_shader_slot(pipelines.clustered.shader, "SpotLights");
+				pipelines.clustered.clusters = *device->get_shader_slot(pipelines.clustered.shader, "Clusters");
+				pipelines.clustered.cluster_indices = *device->get_shader_slot(pipelines.clustered.shader, "ClusterIndices");
 			}
 			lighting::~lighting()
 			{
+				for (auto*& buffer : clusters.buffers)
+					core::memory::release(buffer);
+
+				system->free_shader(pipelines.clustered.shader);
 				system->free_shader(pipelines.surface.shader);
 				system->free_shader(pipelines.line.shader_base);
 				system->free_shader(pipelines.line.shader_shadowed);
@@ -1123,6 +1539,10 @@ namespace vitex
 				series::unpack(node->find("recursive"), &ambient_buffer.recursive);
 				series::unpack(node->find("shadow-distance"), &shadows.distance);
 				series::unpack_a(node->find("sf-size"), &surfaces.size);
+				series::unpack(node->find("clustered"), &clustering.enabled);
+				series::unpack(node->find("cluster-width"), &clustering.width);
+				series::unpack(node->find("cluster-height"), &clustering.height);
+				series::unpack(node->find("cluster-depth"), &clustering.depth);
 			}
 			void lighting::serialize(core::schema* node)
 			{
@@ -1143,6 +1563,10 @@ namespace vitex
 				series::pack(node->set("recursive"), ambient_buffer.recursive);
 				series::pack(node->set("shadow-distance"), shadows.distance);
 				series::pack(node->set("sf-size"), (uint64_t)surfaces.size);
+				series::pack(node->set("clustered"), clustering.enabled);
+				series::pack(node->set("cluster-width"), clustering.width);
+				series::pack(node->set("cluster-height"), clustering.height);
+				series::pack(node->set("cluster-depth"), clustering.depth);
 			}
 			void lighting::resize_buffers()
 			{
@@ -1182,10 +1606,15 @@ namespace vitex
 				state.device->set_vertex_buffer(cube[(size_t)buffer_type::vertex]);
 				state.device->set_index_buffer(cube[(size_t)buffer_type::index], graphics::format::r32_uint);
 				state.device->set_blend_state(blend_additive);
+				clusters.point_volumes.clear();
+				clusters.spot_volumes.clear();
+				clusters.points.clear();
+				clusters.spots.clear();
 
 				render_surface_lights();
 				render_point_lights();
 				render_spot_lights();
+				render_clustered_lights();
 				render_line_lights();
 				render_ambient();
 			}
@@ -1236,6 +1665,36 @@ namespace vitex
 				state.scene->swap_mrt(target_type::main, nullptr);
 				system->restore_view_buffer(nullptr);
 			}
+			void lighting::prepare_shadow_casters()
+			{
+				system->clear_casters();
+				auto& points = state.scene->get_points_mapping(); size_t counter = 0;
+				for (auto* light : lights.points.top())
+				{
+					if (counter >= points.size())
+						break;
+
+					if (!light->shadow.enabled)
+						continue;
+
+					system->add_caster_volume(light->get_entity()->get_transform()->get_position(), light->shadow.distance);
+					counter++;
+				}
+
+				auto& spots = state.scene->get_spots_mapping(); counter = 0;
+				for (auto* light : lights.spots.top())
+				{
+					if (counter >= spots.size())
+						break;
+
+					if (!light->shadow.enabled)
+						continue;
+
+					light->generate_origin();
+					system->add_caster_volume(light->get_entity()->get_transform()->get_position(), light->shadow.distance, light->view * light->projection);
+					counter++;
+				}
+			}
 			void lighting::render_point_shadow_maps(core::timer* time)
 			{
 				auto& buffers = state.scene->get_points_mapping(); size_t counter = 0;
@@ -1255,6 +1714,7 @@ namespace vitex
 					state.device->set_target(target);
 					state.device->clear_depth(target);
 					system->set_view(trigonometry::matrix4x4::identity(), light->projection, light->get_entity()->get_transform()->get_position(), 90.0f, 1.0f, 0.1f, light->shadow.distance, render_culling::depth_cube);
+					system->next_caster_volume();
 					state.scene->statistics.draw_calls += system->render(time, render_state::depth_cube, render_opt::none);
 				}
 			}
@@ -1277,6 +1737,7 @@ namespace vitex
 					state.device->set_target(target);
 					state.device->clear_depth(target);
 					system->set_view(light->view, light->projection, light->get_entity()->get_transform()->get_position(), light->cutoff, 1.0f, 0.1f, light->shadow.distance, render_culling::depth);
+					system->next_caster_volume();
 					state.scene->statistics.draw_calls += system->render(time, render_state::depth, render_opt::backfaces);
 				}
 			}
@@ -1374,6 +1835,17 @@ namespace vitex
 				for (auto* light : lights.points.top())
 				{
 					entity* base = light->get_entity();
+					if (clustering.enabled && (!light->shadow.enabled || !light->depth_map))
+					{
+						position = base->get_transform()->get_position();
+						scale = base->get_radius();
+						load_point_buffer(&point_buffer, light, position, scale, false);
+						point_buffer.lighting *= base->get_visibility(system->view);
+						clusters.point_volumes.push_back({ position, scale.x });
+						clusters.points.push_back(point_buffer);
+						continue;
+					}
+
 					apply_light_culling(light, base->get_radius(), &position, &scale);
 					if (load_point_buffer(&point_buffer, light, position, scale, false))
 					{
@@ -1414,6 +1886,17 @@ namespace vitex
 				for (auto* light : lights.spots.top())
 				{
 					entity* base = light->get_entity();
+					if (clustering.enabled && (!light->shadow.enabled || !light->depth_map_view))
+					{
+						position = base->get_transform()->get_position();
+						scale = base->get_radius();
+						load_spot_buffer(&spot_buffer, light, position, scale, false);
+						spot_buffer.lighting *= base->get_visibility(system->view);
+						clusters.spot_volumes.push_back({ position, scale.x });
+						clusters.spots.push_back(spot_buffer);
+						continue;
+					}
+
 					apply_light_culling(light, base->get_radius(), &position, &scale);
 					if (load_spot_buffer(&spot_buffer, light, position, scale, false))
 					{
@@ -1430,6 +1913,59 @@ namespace vitex
 				}
 				state.device->flush_texture(pipelines.spot.diffuse_buffer, 5, VI_PS);
 			}
+			void lighting::render_clustered_lights()
+			{
+				if (!clustering.enabled || (clusters.points.empty() && clusters.spots.empty()))
+					return;
+
+				clusters.grid.resize(clustering.width, clustering.height, clustering.depth);
+				clusters.grid.bin(system->view, clusters.point_volumes, clusters.spot_volumes);
+
+				auto& cells = clusters.grid.get_cells();
+				auto& indices = clusters.grid.get_indices();
+				if (indices.empty())
+					return;
+
+				if (!update_cluster_buffer(&clusters.buffers[0], clusters.points.data(), sizeof(ipoint_buffer), clusters.points.size()))
+					return;
+
+				if (!update_cluster_buffer(&clusters.buffers[1], clusters.spots.data(), sizeof(ispot_buffer), clusters.spots.size()))
+					return;
+
+				if (!update_cluster_buffer(&clusters.buffers[2], (void*)cells.data(), sizeof(light_clusters::cell), cells.size()))
+					return;
+
+				if (!update_cluster_buffer(&clusters.buffers[3], (void*)indices.data(), sizeof(uint32_t), indices.size()))
+					return;
+
+				cluster_buffer.grid_size = trigonometry::vector3((float)clusters.grid.get_width(), (float)clusters.grid.get_height(), (float)clusters.grid.get_depth());
+				cluster_buffer.slice_scale = clusters.grid.get_slice_scale();
+				cluster_buffer.slice_bias = clusters.grid.get_slice_bias();
+				cluster_buffer.near = clusters.grid.get_near();
+				cluster_buffer.far = clusters.grid.get_far();
+
+				graphics::multi_render_target_2d* mrt = system->get_mrt(target_type::main);
+				graphics::render_target_2d* rt = (system->state.is_subpass() ? system->get_rt(target_type::secondary) : system->get_rt(target_type::main));
+				system->set_constant_buffer(render_buffer_type::view, pipelines.clustered.viewer_buffer, VI_VS | VI_PS);
+				state.device->set_structure_buffer(system->get_material_buffer(), pipelines.clustered.materials, VI_PS);
+				state.device->set_sampler_state(wrap_sampler, pipelines.clustered.sampler, 4, VI_PS);
+				state.device->set_rasterizer_state(back_rasterizer);
+				state.device->set_depth_stencil_state(depth_stencil_none);
+				state.device->set_vertex_buffer(system->get_primitives()->get_quad());
+				state.device->set_texture_2d(rt->get_target(), pipelines.clustered.diffuse_buffer, VI_PS);
+				state.device->set_texture_2d(mrt->get_target(1), pipelines.clustered.normal_buffer, VI_PS);
+				state.device->set_texture_2d(mrt->get_target(2), pipelines.clustered.depth_buffer, VI_PS);
+				state.device->set_texture_2d(mrt->get_target(3), pipelines.clustered.surface_buffer, VI_PS);
+				state.device->set_structure_buffer(clusters.buffers[0], pipelines.clustered.point_lights, VI_PS);
+				state.device->set_structure_buffer(clusters.buffers[1], pipelines.clustered.spot_lights, VI_PS);
+				state.device->set_structure_buffer(clusters.buffers[2], pipelines.clustered.clusters, VI_PS);
+				state.device->set_structure_buffer(clusters.buffers[3], pipelines.clustered.cluster_indices, VI_PS);
+				state.device->set_shader(pipelines.clustered.shader, VI_VS | VI_PS);
+				state.device->set_buffer(pipelines.clustered.shader, pipelines.clustered.cluster_buffer, VI_VS | VI_PS);
+				state.device->update_buffer(pipelines.clustered.shader, &cluster_buffer);
+				state.device->draw(6, 0);
+				state.device->flush_texture(pipelines.clustered.diffuse_buffer, 8, VI_PS);
+			}
 			void lighting::render_line_lights()
 			{
 				if (lights.lines->empty())
@@ -1555,8 +2091,10 @@ namespace vitex
 					{
 						if (shadows.tick.tick_event(time->get_elapsed_mills()))
 						{
+							prepare_shadow_casters();
 							render_point_shadow_maps(time);
 							render_spot_shadow_maps(time);
+							system->clear_casters();
 							render_line_shadow_maps(time);
 							system->restore_view_buffer(nullptr);
 						}
@@ -1698,6 +2236,32 @@ namespace vitex
 				state.device->set_rasterizer_state(front ? front_rasterizer : back_rasterizer);
 				state.device->set_depth_stencil_state(front ? depth_stencil_greater : depth_stencil_less);
 			}
+			bool lighting::update_cluster_buffer(graphics::element_buffer** buffer, void* data, size_t element_width, size_t elements_count)
+			{
+				VI_ASSERT(buffer != nullptr, "buffer should be set");
+				if (!*buffer || (size_t)(*buffer)->get_elements() < elements_count)
+				{
+					graphics::element_buffer::desc f = graphics::element_buffer::desc();
+					f.access_flags = graphics::cpu_access::write;
+					f.misc_flags = graphics::resource_misc::buffer_structured;
+					f.usage = graphics::resource_usage::dynamic;
+					f.bind_flags = graphics::resource_bind::shader_input;
+					f.element_count = (uint32_t)std::max<size_t>(elements_count + elements_count / 2, 16);
+					f.element_width = (uint32_t)element_width;
+					f.structure_byte_stride = f.element_width;
+
+					core::memory::release(*buffer);
+					*buffer = state.device->create_element_buffer(f).or_else(nullptr);
+					if (!*buffer)
+						return false;
+				}
+
+				if (!elements_count)
+					return true;
+
+				auto status = state.device->update_buffer(*buffer, data, element_width * elements_count);
+				return !!status;
+			}
 			graphics::texture_cube* lighting::get_sky_map()
 			{
 				if (!sky_base)
@@ -46,13 +46,21 @@ namespace vitex
 					} geometry;
 				} pipelines;
 
+				struct
+				{
+					core::vector<components::soft_body*> queue;
+					core::vector<trigonometry::vertex> vertices;
+					core::vector<int> indices;
+					graphics::element_buffer* vertex_buffer = nullptr;
+					graphics::element_buffer* index_buffer = nullptr;
+					size_t frame = std::numeric_limits<size_t>::max();
+				} streaming;
+
 			private:
 				graphics::depth_stencil_state* depth_stencil = nullptr;
 				graphics::rasterizer_state* rasterizer = nullptr;
 				graphics::blend_state* blend = nullptr;
 				graphics::sampler_state* sampler = nullptr;
-				graphics::element_buffer* vertex_buffer = nullptr;
-				graphics::element_buffer* index_buffer = nullptr;
 				graphics::element_buffer* group_buffer = nullptr;
 				graphics::input_layout* layout[2];
 				render_buffer::instance group;
@@ -60,10 +68,16 @@ namespace vitex
 			public:
 				soft_body(render_system* lab);
 				~soft_body();
+				void begin_pass(core::timer* time) override;
 				size_t cull_geometry(const viewer& view, const geometry_renderer::objects& chunk) override;
 				size_t render_geometry(core::timer* time, const geometry_renderer::objects& chunk) override;
 				size_t render_depth(core::timer* time, const geometry_renderer::objects& chunk) override;
 				size_t render_depth_cube(core::timer* time, const geometry_renderer::objects& chunk, trigonometry::matrix4x4* view_projection) override;
+				size_t pack_stream();
+
+			private:
+				bool update_stream();
+				bool is_streamed(components::soft_body* base) const;
 
 			public:
 				VI_COMPONENT("soft_body_renderer");
@@ -113,9 +127,20 @@ namespace vitex
 				graphics::sampler_state* sampler = nullptr;
 				graphics::input_layout* layout[2];
 
+			public:
+				struct
+				{
+					float bias = 1.0f;
+					float depth_bias = 0.5f;
+					float hysteresis = 0.1f;
+					bool enabled = true;
+				} levels;
+
 			public:
 				model(render_system* lab);
 				~model() override;
+				void deserialize(core::schema* node) override;
+				void serialize(core::schema* node) override;
 				void batch_geometry(components::model* base, batching& batch, size_t chunk) override;
 				size_t cull_geometry(const viewer& view, const geometry_renderer::objects& chunk) override;
 				size_t render_geometry_batched(core::timer* time, const geometry_renderer::groups& chunk) override;
@@ -124,12 +149,13 @@ namespace vitex
 
 			private:
 				layer::model* get_drawable(components::model* base);
+				size_t get_level(components::model* base, layer::model* drawable, const viewer& view);
 
 			public:
 				VI_COMPONENT("model_renderer");
 			};
 
-			class skin final : public geometry_renderer<components::skin>
+			class skin final : public geometry_renderer<components::skin, graphics::skin_mesh_buffer, render_buffer::skin_instance>
 			{
 			private:
 				struct
@@ -140,8 +166,7 @@ namespace vitex
 						material::slots slotdata;
 						uint32_t sampler = (uint32_t)-1;
 						uint32_t materials = (uint32_t)-1;
-						uint32_t animation_buffer = (uint32_t)-1;
-						uint32_t object_buffer = (uint32_t)-1;
+						uint32_t palette = (uint32_t)-1;
 					} depth;
 					struct
 					{
@@ -149,14 +174,14 @@ namespace vitex
 						material::slots slotdata;
 						uint32_t sampler = (uint32_t)-1;
 						uint32_t materials = (uint32_t)-1;
-						uint32_t animation_buffer = (uint32_t)-1;
-						uint32_t object_buffer = (uint32_t)-1;
+						uint32_t palette = (uint32_t)-1;
 						uint32_t viewer_buffer = (uint32_t)-1;
 						uint32_t cube_buffer = (uint32_t)-1;
 					} depth_cube;
 					struct
 					{
 						graphics::shader* shader = nullptr;
+						uint32_t palette = (uint32_t)-1;
 						uint32_t animation_buffer = (uint32_t)-1;
 						uint32_t object_buffer = (uint32_t)-1;
 					} culling;
@@ -166,29 +191,40 @@ namespace vitex
 						material::slots slotdata;
 						uint32_t sampler = (uint32_t)-1;
 						uint32_t materials = (uint32_t)-1;
-						uint32_t animation_buffer = (uint32_t)-1;
-						uint32_t object_buffer = (uint32_t)-1;
+						uint32_t palette = (uint32_t)-1;
 						uint32_t viewer_buffer = (uint32_t)-1;
 					} geometry;
 				} pipelines;
 
+				struct
+				{
+					core::vector<trigonometry::matrix4x4> data;
+					graphics::element_buffer* buffer = nullptr;
+					size_t frame = std::numeric_limits<size_t>::max();
+				} palette;
+
 			private:
 				graphics::depth_stencil_state* depth_stencil = nullptr;
 				graphics::rasterizer_state* back_rasterizer = nullptr;
 				graphics::rasterizer_state* front_rasterizer = nullptr;
 				graphics::blend_state* blend = nullptr;
 				graphics::sampler_state* sampler = nullptr;
-				graphics::input_layout* layout = nullptr;
+				graphics::input_layout* layout[2];
 
 			public:
 				skin(render_system* lab);
-				~skin();
+				~skin() override;
+				void begin_pass(core::timer* time) override;
+				void batch_geometry(components::skin* base, batching& batch, size_t chunk) override;
 				size_t cull_geometry(const viewer& view, const geometry_renderer::objects& chunk) override;
-				size_t render_geometry(core::timer* time, const geometry_renderer::objects& chunk) override;
-				size_t render_depth(core::timer* time, const geometry_renderer::objects& chunk) override;
-				size_t render_depth_cube(core::timer* time, const geometry_renderer::objects& chunk, trigonometry::matrix4x4* view_projection) override;
+				size_t render_geometry_batched(core::timer* time, const geometry_renderer::groups& chunk) override;
+				size_t render_depth_batched(core::timer* time, const geometry_renderer::groups& chunk) override;
+				size_t render_depth_cube_batched(core::timer* time, const geometry_renderer::groups& chunk, trigonometry::matrix4x4* view_projection) override;
+				size_t pack_palette();
+				const core::vector<trigonometry::matrix4x4>& get_palette() const;
 
 			private:
+				bool update_palette();
 				layer::skin_model* get_drawable(components::skin* base);
 
 			public:
@@ -308,6 +344,75 @@ namespace vitex
 				VI_COMPONENT("decal_renderer");
 			};
 
+			class light_clusters
+			{
+			public:
+				struct cell
+				{
+					uint32_t offset = 0;
+					uint32_t points = 0;
+					uint32_t spots = 0;
+					uint32_t padding = 0;
+				};
+
+				struct volume
+				{
+					trigonometry::vector3 position;
+					float radius = 0.0f;
+				};
+
+			private:
+				struct extent
+				{
+					uint32_t min_x = 1;
+					uint32_t max_x = 0;
+					uint32_t min_y = 1;
+					uint32_t max_y = 0;
+					uint32_t min_z = 1;
+					uint32_t max_z = 0;
+				};
+
+				struct slice
+				{
+					core::vector<uint32_t> indices;
+					uint32_t index = 0;
+				};
+
+			private:
+				core::vector<extent> extents[2];
+				core::vector<slice> slices;
+				core::vector<uint32_t> indices;
+				core::vector<cell> cells;
+				float slice_scale;
+				float slice_bias;
+				float near_plane;
+				float far_plane;
+				uint32_t width;
+				uint32_t height;
+				uint32_t depth;
+
+			public:
+				light_clusters(uint32_t new_width = 16, uint32_t new_height = 9, uint32_t new_depth = 24) noexcept;
+				void resize(uint32_t new_width, uint32_t new_height, uint32_t new_depth);
+				void bin(const viewer& view, const core::vector<volume>& points, const core::vector<volume>& spots);
+				void clear();
+				const core::vector<cell>& get_cells() const;
+				const core::vector<uint32_t>& get_indices() const;
+				const cell& get_cell(uint32_t x, uint32_t y, uint32_t z) const;
+				float get_slice_scale() const;
+				float get_slice_bias() const;
+				float get_near() const;
+				float get_far() const;
+				uint32_t get_width() const;
+				uint32_t get_height() const;
+				uint32_t get_depth() const;
+
+			private:
+				void bin_slice(slice& next);
+				void compute_extents(const viewer& view, const core::vector<volume>& volumes, core::vector<extent>& output);
+				uint32_t get_slice(float distance) const;
+			};
+
 			class lighting final : public renderer
 			{
 			public:
@@ -394,6 +499,16 @@ namespace vitex
 					float recursive = 1.0f;
 				};
 
+				struct icluster_buffer
+				{
+					trigonometry::vector3 grid_size;
+					float slice_scale = 0.0f;
+					float slice_bias = 0.0f;
+					float near = 0.0f;
+					float far = 0.0f;
+					float padding = 0.0f;
+				};
+
 			protected:
 				struct
 				{
@@ -470,6 +585,22 @@ namespace vitex
 						uint32_t surface_buffer = (uint32_t)-1;
 						uint32_t environment_map = (uint32_t)-1;
 					} surface;
+					struct
+					{
+						graphics::shader* shader = nullptr;
+						uint32_t materials = (uint32_t)-1;
+						uint32_t sampler = (uint32_t)-1;
+						uint32_t viewer_buffer = (uint32_t)-1;
+						uint32_t cluster_buffer = (uint32_t)-1;
+						uint32_t diffuse_buffer = (uint32_t)-1;
+						uint32_t normal_buffer = (uint32_t)-1;
+						uint32_t depth_buffer = (uint32_t)-1;
+						uint32_t surface_buffer = (uint32_t)-1;
+						uint32_t point_lights = (uint32_t)-1;
+						uint32_t spot_lights = (uint32_t)-1;
+						uint32_t clusters = (uint32_t)-1;
+						uint32_t cluster_indices = (uint32_t)-1;
+					} clustered;
 				} pipelines;
 
 				struct
@@ -487,6 +618,16 @@ namespace vitex
 					core::pool<component*>* lines;
 				} lights;
 
+				struct
+				{
+					light_clusters grid;
+					core::vector<light_clusters::volume> point_volumes;
+					core::vector<light_clusters::volume> spot_volumes;
+					core::vector<ipoint_buffer> points;
+					core::vector<ispot_buffer> spots;
+					graphics::element_buffer* buffers[4] = { nullptr };
+				} clusters;
+
 			public:
 				struct
 				{
@@ -504,6 +645,14 @@ namespace vitex
 					size_t size = 128;
 				} surfaces;
 
+				struct
+				{
+					uint32_t width = 16;
+					uint32_t height = 9;
+					uint32_t depth = 24;
+					bool enabled = true;
+				} clustering;
+
 			private:
 				graphics::depth_stencil_state* depth_stencil_none = nullptr;
 				graphics::depth_stencil_state* depth_stencil_greater = nullptr;
@@ -524,6 +673,7 @@ namespace vitex
 				ipoint_buffer point_buffer;
 				ispot_buffer spot_buffer;
 				iline_buffer line_buffer;
+				icluster_buffer cluster_buffer;
 
 			public:
 				graphics::texture_2d* lighting_map = nullptr;
@@ -550,14 +700,17 @@ namespace vitex
 				bool load_spot_buffer(ispot_buffer* dest, component* src, trigonometry::vector3& position, trigonometry::vector3& scale, bool reposition);
 				bool load_line_buffer(iline_buffer* dest, component* src);
 				void apply_light_culling(component* src, float range, trigonometry::vector3* position, trigonometry::vector3* scale);
+				bool update_cluster_buffer(graphics::element_buffer** buffer, void* data, size_t element_width, size_t elements_count);
 				void render_result_buffers();
 				void render_surface_maps(core::timer* time);
+				void prepare_shadow_casters();
 				void render_point_shadow_maps(core::timer* time);
 				void render_spot_shadow_maps(core::timer* time);
 				void render_line_shadow_maps(core::timer* time);
 				void render_surface_lights();
 				void render_point_lights();
 				void render_spot_lights();
+				void render_clustered_lights();
 				void render_line_lights();
 				void render_ambient();
 
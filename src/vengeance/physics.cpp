@@ -1220,23 +1220,25 @@ namespace vitex
 			VI_ASSERT(instance != nullptr, "softbody should be initialized");
 			VI_ASSERT(result != nullptr, "result should be set");
 
-			static size_t position_x = offsetof(trigonometry::vertex, position_x);
-			static size_t normal_x = offsetof(trigonometry::vertex, normal_x);
-
 			size_t size = (size_t)instance->m_nodes.size();
 			if (result->size() != size)
 			{
 				if (initial.shape.convex.enabled)
 					*result = initial.shape.convex.hull->get_vertices();
-				else
-					result->resize(size);
+				result->resize(size);
 			}
 
-			for (size_t i = 0; i < size; i++)
+			trigonometry::vertex* output = result->data();
+			for (int i = 0; i < (int)size; i++)
 			{
-				auto* node = &instance->m_nodes[(int)i]; trigonometry::vertex& position = result->at(i);
-				memcpy(&position + position_x, node->m_x.m_floats, sizeof(float) * 3);
-				memcpy(&position + normal_x, node->m_n.m_floats, sizeof(float) * 3);
+				auto& node = instance->m_nodes[i];
+				auto& next = output[i];
+				next.position_x = node.m_x.x();
+				next.position_y = node.m_x.y();
+				next.position_z = node.m_x.z();
+				next.normal_x = node.m_n.x();
+				next.normal_y = node.m_n.y();
+				next.normal_z = node.m_n.z();
 			}
 #endif
 		}
@@ -26,6 +26,95 @@ namespace
 		result.append(data).append("\"");
 		return result;
 	}
+	float find_track_keys(const vitex::trigonometry::skin_animator_track& track, const float* times, float time, size_t& from, size_t& to)
+	{
+		from = to = track.offset;
+		if (track.count <= 1)
+			return 0.0f;
+
+		const float* begin = times + track.offset;
+		const float* end = begin + track.count;
+		const float* next = std::upper_bound(begin, end, time);
+		if (next == begin)
+			return 0.0f;
+
+		if (next == end)
+		{
+			from = to = track.offset + track.count - 1;
+			return 0.0f;
+		}
+
+		to = track.offset + (size_t)(next - begin);
+		from = to - 1;
+
+		float span = times[to] - times[from];
+		return span > 0.0f ? (time - times[from]) / span : 0.0f;
+	}
+	template <typename t, typename lerp_callback, typename error_callback>
+	void reduce_track(const vitex::core::vector<float>& times, const vitex::core::vector<t>& values, float tolerance, lerp_callback&& lerp, error_callback&& error, vitex::core::vector<size_t>& indices)
+	{
+		indices.clear();
+		if (values.empty())
+			return;
+
+		indices.push_back(0);
+		bool constant = true;
+		for (size_t i = 1; i < values.size() && constant; i++)
+			constant = error(values[0], values[i]) <= tolerance;
+
+		if (constant)
+			return;
+
+		size_t anchor = 0;
+		for (size_t next = 2; next < values.size(); next++)
+		{
+			float span = times[next] - times[anchor];
+			for (size_t i = anchor + 1; i < next; i++)
+			{
+				float delta = span > 0.0f ? (times[i] - times[anchor]) / span : 0.0f;
+				if (error(lerp(values[anchor], values[next], delta), values[i]) > tolerance)
+				{
+					anchor = next - 1;
+					indices.push_back(anchor);
+					break;
+				}
+			}
+		}
+
+		indices.push_back(values.size() - 1);
+	}
+
+	struct mesh_quadric
+	{
+		double a2 = 0.0, b2 = 0.0, c2 = 0.0, d2 = 0.0;
+		double ab = 0.0, ac = 0.0, ad = 0.0;
+		double bc = 0.0, bd = 0.0, cd = 0.0;
+
+		void add_plane(double a, double b, double c, double d)
+		{
+			a2 += a * a; b2 += b * b; c2 += c * c; d2 += d * d;
+			ab += a * b; ac += a * c; ad += a * d;
+			bc += b * c; bd += b * d; cd += c * d;
+		}
+		void add(const mesh_quadric& other)
+		{
+			a2 += other.a2; b2 += other.b2; c2 += other.c2; d2 += other.d2;
+			ab += other.ab; ac += other.ac; ad += other.ad;
+			bc += other.bc; bd += other.bd; cd += other.cd;
+		}
+		double evaluate(const vitex::trigonometry::vector3& point) const
+		{
+			double x = point.x, y = point.y, z = point.z;
+			return a2 * x * x + b2 * y * y + c2 * z * z + d2 + 2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+		}
+	};
+
+	struct mesh_collapse
+	{
+		double cost;
+		uint32_t from;
+		uint32_t to;
+	};
 }
 
 namespace vitex
@@ -1572,6 +1661,106 @@ namespace vitex
 		{
 			return bounds.upper >= lower && bounds.lower <= upper;
 		}
+		bool bounding::overlaps_sphere(const vector3& point, float size) const
+		{
+			float x = std::max(lower.x - point.x, std::max(0.0f, point.x - upper.x));
+			float y = std::max(lower.y - point.y, std::max(0.0f, point.y - upper.y));
+			float z = std::max(lower.z - point.z, std::max(0.0f, point.z - upper.z));
+			return x * x + y * y + z * z <= size * size;
+		}
+		bool bounding::overlaps_capsule(const vector3& start, const vector3& end, float size) const
+		{
+			vector3 axis = end - start;
+			float a = 0.0f, b = 1.0f;
+			for (size_t i = 0; i < 24; i++)
+			{
+				float c = a + (b - a) / 3.0f;
+				float d = b - (b - a) / 3.0f;
+				float near_distance = get_distance(start + axis * c);
+				float far_distance = get_distance(start + axis * d);
+				if (near_distance <= size || far_distance <= size)
+					return true;
+				else if (near_distance < far_distance)
+					b = d;
+				else
+					a = c;
+			}
+
+			return get_distance(start + axis * ((a + b) * 0.5f)) <= size;
+		}
+		bool bounding::overlaps_obb(const matrix4x4& world) const
+		{
+			vector3 axes[3] = { vector3(world.row[0], world.row[1], world.row[2]), vector3(world.row[4], world.row[5], world.row[6]), vector3(world.row[8], world.row[9], world.row[10]) };
+			vector3 offset = vector3(world.row[12], world.row[13], world.row[14]) - center;
+			float extents[3] = { (upper.x - lower.x) * 0.5f, (upper.y - lower.y) * 0.5f, (upper.z - lower.z) * 0.5f };
+			float scales[3], rotation[3][3], absolute[3][3];
+			for (size_t i = 0; i < 3; i++)
+			{
+				scales[i] = axes[i].length();
+				axes[i] = scales[i] > std::numeric_limits<float>::epsilon() ? axes[i] / scales[i] : vector3::zero();
+			}
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				for (size_t j = 0; j < 3; j++)
+				{
+					rotation[i][j] = (i == 0 ? axes[j].x : (i == 1 ? axes[j].y : axes[j].z));
+					absolute[i][j] = std::abs(rotation[i][j]) + std::numeric_limits<float>::epsilon();
+				}
+			}
+
+			float distance[3] = { offset.x, offset.y, offset.z };
+			for (size_t i = 0; i < 3; i++)
+			{
+				float radius = scales[0] * absolute[i][0] + scales[1] * absolute[i][1] + scales[2] * absolute[i][2];
+				if (std::abs(distance[i]) > extents[i] + radius)
+					return false;
+			}
+
+			for (size_t j = 0; j < 3; j++)
+			{
+				float radius = extents[0] * absolute[0][j] + extents[1] * absolute[1][j] + extents[2] * absolute[2][j];
+				if (std::abs(distance[0] * rotation[0][j] + distance[1] * rotation[1][j] + distance[2] * rotation[2][j]) > radius + scales[j])
+					return false;
+			}
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+				for (size_t j = 0; j < 3; j++)
+				{
+					size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+					float a = extents[i1] * absolute[i2][j] + extents[i2] * absolute[i1][j];
+					float b = scales[j1] * absolute[i][j2] + scales[j2] * absolute[i][j1];
+					if (std::abs(distance[i2] * rotation[i1][j] - distance[i1] * rotation[i2][j]) > a + b)
+						return false;
+				}
+			}
+
+			return true;
+		}
+		bool bounding::overlaps_cone(const vector3& origin, const vector3& direction, float range, float angle) const
+		{
+			vector3 offset = center - origin;
+			float size = (upper - lower).length() * 0.5f;
+			float length = offset.dot(offset);
+			if (length <= size * size)
+				return true;
+
+			float projection = offset.dot(direction);
+			if (projection < -size || projection > range + size)
+				return false;
+
+			float axis = std::sqrt(std::max(0.0f, length - projection * projection));
+			return std::cos(angle) * axis - std::sin(angle) * projection <= size;
+		}
+		float bounding::get_distance(const vector3& point) const
+		{
+			float x = std::max(lower.x - point.x, std::max(0.0f, point.x - upper.x));
+			float y = std::max(lower.y - point.y, std::max(0.0f, point.y - upper.y));
+			float z = std::max(lower.z - point.z, std::max(0.0f, point.z - upper.z));
+			return std::sqrt(x * x + y * y + z * z);
+		}
 
 		frustum8c::frustum8c() noexcept
 		{
@@ -3072,6 +3261,160 @@ namespace vitex
 			return !(*this == v);
 		}
 
+		void skin_animator_compressed_clip::sample(float time, core::vector<animator_key>& pose) const
+		{
+			size_t joints = get_joints_count();
+			if (pose.size() < joints)
+				pose.resize(joints);
+
+			size_t from, to;
+			for (size_t i = 0; i < joints; i++)
+			{
+				auto& target = pose[i];
+				float delta = find_track_keys(position_tracks[i], position_times.data(), time, from, to);
+				target.position = positions[from].lerp(positions[to], delta);
+
+				delta = find_track_keys(rotation_tracks[i], rotation_times.data(), time, from, to);
+				target.rotation = (from == to ? unpack_rotation(rotations[from]) : unpack_rotation(rotations[from]).slerp(unpack_rotation(rotations[to]), delta));
+
+				delta = find_track_keys(scale_tracks[i], scale_times.data(), time, from, to);
+				target.scale = scales[from].lerp(scales[to], delta);
+				target.time = time;
+			}
+		}
+		void skin_animator_compressed_clip::sample_frame(size_t frame, core::vector<animator_key>& pose) const
+		{
+			if (!timeline.empty())
+				sample(timeline[std::min(frame, timeline.size() - 1)], pose);
+		}
+		size_t skin_animator_compressed_clip::get_joints_count() const
+		{
+			return position_tracks.size();
+		}
+		size_t skin_animator_compressed_clip::get_frames_count() const
+		{
+			return timeline.size();
+		}
+		size_t skin_animator_compressed_clip::get_memory_usage() const
+		{
+			size_t tracks = position_tracks.size() + rotation_tracks.size() + scale_tracks.size();
+			size_t times = position_times.size() + rotation_times.size() + scale_times.size() + timeline.size();
+			return sizeof(*this) + name.size() + tracks * sizeof(skin_animator_track) + times * sizeof(float) + (positions.size() + scales.size()) * sizeof(vector3) + rotations.size() * sizeof(uint64_t);
+		}
+		skin_animator_compressed_clip skin_animator_compressed_clip::compress(const skin_animator_clip& clip, float position_tolerance, float rotation_tolerance, float scale_tolerance)
+		{
+			skin_animator_compressed_clip result;
+			result.name = clip.name;
+			result.duration = clip.duration;
+			result.rate = clip.rate;
+			result.timeline.reserve(clip.keys.size());
+
+			size_t joints = clip.keys.empty() ? 0 : clip.keys.front().pose.size();
+			for (auto& key : clip.keys)
+			{
+				result.timeline.push_back(key.time);
+				joints = std::min(joints, key.pose.size());
+			}
+
+			size_t frames = clip.keys.size();
+			core::vector<vector3> positions(frames), scales(frames);
+			core::vector<quaternion> rotations(frames);
+			core::vector<size_t> indices;
+			result.position_tracks.resize(joints);
+			result.rotation_tracks.resize(joints);
+			result.scale_tracks.resize(joints);
+
+			for (size_t joint = 0; joint < joints; joint++)
+			{
+				for (size_t frame = 0; frame < frames; frame++)
+				{
+					auto& key = clip.keys[frame].pose[joint];
+					positions[frame] = key.position;
+					rotations[frame] = key.rotation.normalize();
+					scales[frame] = key.scale;
+				}
+
+				reduce_track(result.timeline, positions, position_tolerance, [](const vector3& a, const vector3& b, float t) { return a.lerp(b, t); }, [](const vector3& a, const vector3& b) { return a.distance(b); }, indices);
+				auto& position = result.position_tracks[joint];
+				position.offset = (uint32_t)result.positions.size();
+				position.count = (uint32_t)indices.size();
+				for (size_t index : indices)
+				{
+					result.position_times.push_back(result.timeline[index]);
+					result.positions.push_back(positions[index]);
+				}
+
+				reduce_track(result.timeline, rotations, rotation_tolerance, [](const quaternion& a, const quaternion& b, float t) { return a.slerp(b, t); }, [](const quaternion& a, const quaternion& b) { return 1.0f - std::abs(a.dot(b)); }, indices);
+				auto& rotation = result.rotation_tracks[joint];
+				rotation.offset = (uint32_t)result.rotations.size();
+				rotation.count = (uint32_t)indices.size();
+				for (size_t index : indices)
+				{
+					result.rotation_times.push_back(result.timeline[index]);
+					result.rotations.push_back(pack_rotation(rotations[index]));
+				}
+
+				reduce_track(result.timeline, scales, scale_tolerance, [](const vector3& a, const vector3& b, float t) { return a.lerp(b, t); }, [](const vector3& a, const vector3& b) { return a.distance(b); }, indices);
+				auto& scale = result.scale_tracks[joint];
+				scale.offset = (uint32_t)result.scales.size();
+				scale.count = (uint32_t)indices.size();
+				for (size_t index : indices)
+				{
+					result.scale_times.push_back(result.timeline[index]);
+					result.scales.push_back(scales[index]);
+				}
+			}
+
+			return result;
+		}
+		uint64_t skin_animator_compressed_clip::pack_rotation(const quaternion& value)
+		{
+			quaternion normal = value.normalize();
+			float components[4] = { normal.x, normal.y, normal.z, normal.w };
+			uint32_t largest = 0;
+			for (uint32_t i = 1; i < 4; i++)
+			{
+				if (std::abs(components[i]) > std::abs(components[largest]))
+					largest = i;
+			}
+
+			float sign = (components[largest] < 0.0f ? -1.0f : 1.0f);
+			uint64_t result = (uint64_t)largest;
+			uint32_t shift = 2;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (i == largest)
+					continue;
+
+				float scaled = (components[i] * sign * 1.41421356f + 1.0f) * 0.5f;
+				uint64_t quantized = (uint64_t)(std::clamp(scaled, 0.0f, 1.0f) * 1048575.0f + 0.5f);
+				result |= quantized << shift;
+				shift += 20;
+			}
+
+			return result;
+		}
+		quaternion skin_animator_compressed_clip::unpack_rotation(uint64_t value)
+		{
+			uint32_t largest = (uint32_t)(value & 0x3);
+			float components[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float sum = 0.0f;
+			uint32_t shift = 2;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (i == largest)
+					continue;
+
+				float scaled = (float)((value >> shift) & 0xFFFFF) / 1048575.0f;
+				components[i] = (scaled * 2.0f - 1.0f) * 0.70710678f;
+				sum += components[i] * components[i];
+				shift += 20;
+			}
+
+			components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+			return quaternion(components[0], components[1], components[2], components[3]);
+		}
+
 		random_vector2::random_vector2() noexcept : min(0), max(1), intensity(false), accuracy(1)
 		{
 		}
@@ -3659,13 +4002,13 @@ namespace vitex
 
 		radix_sorter::radix_sorter() noexcept : current_size(0), indices(nullptr), indices2(nullptr)
 		{
-			histogram = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256 * 4);
+			histogram = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256 * 8);
 			offset = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256);
 			reset_indices();
 		}
 		radix_sorter::radix_sorter(const radix_sorter& other) noexcept : current_size(0), indices(nullptr), indices2(nullptr)
 		{
-			histogram = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256 * 4);
+			histogram = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256 * 8);
 			offset = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256);
 			reset_indices();
 		}
@@ -3687,7 +4030,7 @@ namespace vitex
 		radix_sorter& radix_sorter::operator =(const radix_sorter& v)
 		{
 			core::memory::deallocate(histogram);
-			histogram = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256 * 4);
+			histogram = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256 * 8);
 
 			core::memory::deallocate(offset);
 			offset = core::memory::allocate<uint32_t>(sizeof(uint32_t) * 256);
@@ -3950,6 +4293,72 @@ namespace vitex
 
 			return *this;
 		}
+		radix_sorter& radix_sorter::sort(uint64_t* input, uint32_t nb)
+		{
+			if (nb > current_size)
+			{
+				core::memory::deallocate(indices2);
+				core::memory::deallocate(indices);
+				indices = core::memory::allocate<uint32_t>(sizeof(uint32_t) * nb);
+				indices2 = core::memory::allocate<uint32_t>(sizeof(uint32_t) * nb);
+				current_size = nb;
+			}
+
+			for (uint32_t i = 0; i < nb; i++)
+				indices[i] = i;
+
+			if (nb < 2)
+				return *this;
+
+			memset(histogram, 0, 256 * 8 * sizeof(uint32_t));
+			{
+				bool already_sorted = true;
+				uint64_t prev_val = input[0];
+				uint8_t* p = (uint8_t*)input;
+				uint8_t* pe = &p[(size_t)nb * 8];
+				uint64_t* v = input;
+
+				while (p != pe)
+				{
+					uint64_t val = *v++;
+					if (val < prev_val)
+						already_sorted = false;
+
+					prev_val = val;
+					for (uint32_t j = 0; j < 8; j++)
+						histogram[(j << 8) + *p++]++;
+				}
+
+				if (already_sorted)
+					return *this;
+			}
+
+			for (uint32_t j = 0; j < 8; j++)
+			{
+				uint32_t* cur_count = &histogram[j << 8];
+				uint8_t* input_bytes = (uint8_t*)input + j;
+				if (cur_count[input_bytes[0]] == nb)
+					continue;
+
+				offset[0] = 0;
+				for (uint32_t i = 1; i < 256; i++)
+					offset[i] = offset[i - 1] + cur_count[i - 1];
+
+				uint32_t* indices_start = indices;
+				uint32_t* indices_end = &indices[nb];
+				while (indices_start != indices_end)
+				{
+					uint32_t id = *indices_start++;
+					indices2[offset[input_bytes[(size_t)id << 3]]++] = id;
+				}
+
+				uint32_t* tmp = indices;
+				indices = indices2;
+				indices2 = tmp;
+			}
+
+			return *this;
+		}
 		radix_sorter& radix_sorter::reset_indices()
 		{
 			for (uint32_t i = 0; i < current_size; i++)
@@ -4356,6 +4765,406 @@ namespace vitex
 		{
 			return vector2(cosf(a), sinf(a)).distance(vector2(cosf(b), sinf(b)));
 		}
+		void geometric::transform_points(const vector3* input, vector3* output, size_t count, const matrix4x4& matrix)
+		{
+			VI_ASSERT(!count || (input != nullptr && output != nullptr), "input and output should be set");
+#ifdef VI_VECTORCLASS
+			LOAD_VAR(_r4, matrix.row);
+			LOAD_VAR(_r5, matrix.row + 4);
+			LOAD_VAR(_r6, matrix.row + 8);
+			LOAD_VAR(_r7, matrix.row + 12);
+			for (size_t i = 0; i < count; i++)
+			{
+				auto& next = input[i];
+				Vec4f _r1 = _r4 * next.x + _r5 * next.y + _r6 * next.z + _r7;
+				output[i] = vector3(_r1.extract(0), _r1.extract(1), _r1.extract(2));
+			}
+#else
+			for (size_t i = 0; i < count; i++)
+			{
+				auto& next = input[i];
+				output[i] = vector3(
+					next.x * matrix.row[0] + next.y * matrix.row[4] + next.z * matrix.row[8] + matrix.row[12],
+					next.x * matrix.row[1] + next.y * matrix.row[5] + next.z * matrix.row[9] + matrix.row[13],
+					next.x * matrix.row[2] + next.y * matrix.row[6] + next.z * matrix.row[10] + matrix.row[14]);
+			}
+#endif
+		}
+		void geometric::transform_matrices(const matrix4x4* input, matrix4x4* output, size_t count, const matrix4x4& matrix)
+		{
+			VI_ASSERT(!count || (input != nullptr && output != nullptr), "input and output should be set");
+			for (size_t i = 0; i < count; i++)
+				output[i] = input[i].mul(matrix);
+		}
+		void geometric::lerp_points(const vector3* from, const vector3* to, vector3* output, size_t count, float delta_time)
+		{
+			VI_ASSERT(!count || (from != nullptr && to != nullptr && output != nullptr), "input and output should be set");
+#ifdef VI_VECTORCLASS
+			for (size_t i = 0; i < count; i++)
+			{
+				LOAD_V3(_r1, from[i]); LOAD_V3(_r2, to[i]);
+				_r1 += (_r2 - _r1) * delta_time;
+				output[i] = vector3(_r1.extract(0), _r1.extract(1), _r1.extract(2));
+			}
+#else
+			for (size_t i = 0; i < count; i++)
+				output[i] = from[i] + (to[i] - from[i]) * delta_time;
+#endif
+		}
+		void geometric::normalize_points(const vector3* input, vector3* output, size_t count)
+		{
+			VI_ASSERT(!count || (input != nullptr && output != nullptr), "input and output should be set");
+#ifdef VI_VECTORCLASS
+			for (size_t i = 0; i < count; i++)
+			{
+				LOAD_V3(_r1, input[i]);
+				float length = std::sqrt(horizontal_add(square(_r1)));
+				if (length > std::numeric_limits<float>::epsilon())
+					_r1 /= length;
+				output[i] = vector3(_r1.extract(0), _r1.extract(1), _r1.extract(2));
+			}
+#else
+			for (size_t i = 0; i < count; i++)
+			{
+				auto& next = input[i];
+				float length = std::sqrt(next.x * next.x + next.y * next.y + next.z * next.z);
+				output[i] = length > std::numeric_limits<float>::epsilon() ? next / length : next;
+			}
+#endif
+		}
+		void geometric::distance_points(const vector3* input, float* output, size_t count, const vector3& point)
+		{
+			VI_ASSERT(!count || (input != nullptr && output != nullptr), "input and output should be set");
+#ifdef VI_VECTORCLASS
+			LOAD_V3(_r2, point);
+			for (size_t i = 0; i < count; i++)
+			{
+				LOAD_V3(_r1, input[i]);
+				output[i] = std::sqrt(horizontal_add(square(_r1 - _r2)));
+			}
+#else
+			for (size_t i = 0; i < count; i++)
+			{
+				float x = input[i].x - point.x, y = input[i].y - point.y, z = input[i].z - point.z;
+				output[i] = std::sqrt(x * x + y * y + z * z);
+			}
+#endif
+		}
+		bool geometric::reduce_bounds(const vector3* input, size_t count, vector3& min, vector3& max)
+		{
+			if (!count || !input)
+				return false;
+#ifdef VI_VECTORCLASS
+			LOAD_V3(_r1, input[0]);
+			Vec4f _r2 = _r1;
+			for (size_t i = 1; i < count; i++)
+			{
+				LOAD_V3(_r3, input[i]);
+				_r1 = ::min(_r1, _r3);
+				_r2 = ::max(_r2, _r3);
+			}
+
+			min = vector3(_r1.extract(0), _r1.extract(1), _r1.extract(2));
+			max = vector3(_r2.extract(0), _r2.extract(1), _r2.extract(2));
+#else
+			min = max = input[0];
+			for (size_t i = 1; i < count; i++)
+			{
+				auto& next = input[i];
+				min = vector3(std::min(min.x, next.x), std::min(min.y, next.y), std::min(min.z, next.z));
+				max = vector3(std::max(max.x, next.x), std::max(max.y, next.y), std::max(max.z, next.z));
+			}
+#endif
+			return true;
+		}
+		core::vector<int> geometric::simplify_triangle_list(const core::vector<vector3>& positions, const core::vector<int>& indices, size_t target_count, float max_error, float* result_error)
+		{
+			VI_ASSERT(indices.size() % 3 == 0, "indices should form a triangle list");
+			core::vector<int> result = indices;
+			if (result_error != nullptr)
+				*result_error = 0.0f;
+
+			vector3 min, max;
+			if (result.size() <= target_count || !reduce_bounds(positions.data(), positions.size(), min, max))
+				return result;
+
+			float extent = min.distance(max);
+			if (extent <= 0.0f)
+				return result;
+
+			uint32_t count = (uint32_t)positions.size();
+			core::vector<uint32_t> order(count), welds(count);
+			for (uint32_t i = 0; i < count; i++)
+				order[i] = i;
+
+			std::sort(order.begin(), order.end(), [&positions](uint32_t a, uint32_t b)
+			{
+				auto& left = positions[a], &right = positions[b];
+				if (left.x != right.x)
+					return left.x < right.x;
+				if (left.y != right.y)
+					return left.y < right.y;
+				return left.z < right.z;
+			});
+
+			enum { manifold = 0, border = 1, seam = 2 };
+			core::vector<uint8_t> kinds(count, manifold);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t index = order[i];
+				welds[index] = index;
+				if (i > 0 && positions[order[i - 1]] == positions[index])
+				{
+					welds[index] = welds[order[i - 1]];
+					kinds[index] = kinds[welds[index]] = seam;
+				}
+			}
+
+			core::unordered_map<uint64_t, uint32_t> edges;
+			edges.reserve(result.size());
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				for (size_t j = 0; j < 3; j++)
+				{
+					uint64_t a = welds[(uint32_t)result[i + j]], b = welds[(uint32_t)result[i + (j + 1) % 3]];
+					++edges[a < b ? (a << 32) | b : (b << 32) | a];
+				}
+			}
+
+			for (auto& edge : edges)
+			{
+				if (edge.second == 2)
+					continue;
+
+				uint32_t a = (uint32_t)(edge.first >> 32), b = (uint32_t)(edge.first & 0xffffffff);
+				kinds[a] = std::max<uint8_t>(kinds[a], border);
+				kinds[b] = std::max<uint8_t>(kinds[b], border);
+			}
+
+			core::vector<mesh_quadric> quadrics(count);
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				auto& p0 = positions[result[i + 0]], &p1 = positions[result[i + 1]], &p2 = positions[result[i + 2]];
+				vector3 normal = (p1 - p0).cross(p2 - p0);
+				float length = normal.length();
+				if (length <= 0.0f)
+					continue;
+
+				normal = normal / length;
+				double distance = -normal.dot(p0);
+				for (size_t j = 0; j < 3; j++)
+					quadrics[result[i + j]].add_plane(normal.x, normal.y, normal.z, distance);
+			}
+
+			double threshold = (double)max_error * (double)extent;
+			threshold *= threshold;
+
+			double worst = 0.0;
+			core::vector<mesh_collapse> candidates;
+			core::vector<uint32_t> offsets, adjacency, collapses(count);
+			core::vector<uint8_t> touched(count);
+			while (result.size() > target_count)
+			{
+				candidates.clear();
+				for (size_t i = 0; i < result.size(); i += 3)
+				{
+					for (size_t j = 0; j < 3; j++)
+					{
+						uint32_t a = (uint32_t)result[i + j], b = (uint32_t)result[i + (j + 1) % 3];
+						for (size_t k = 0; k < 2; k++, std::swap(a, b))
+						{
+							if (kinds[a] != manifold || kinds[b] == seam)
+								continue;
+
+							mesh_quadric next = quadrics[a];
+							next.add(quadrics[b]);
+							candidates.push_back({ next.evaluate(positions[b]), a, b });
+						}
+					}
+				}
+
+				std::sort(candidates.begin(), candidates.end(), [](const mesh_collapse& a, const mesh_collapse& b) { return a.cost < b.cost; });
+				offsets.assign(count + 1, 0);
+				for (int index : result)
+					++offsets[index + 1];
+				for (uint32_t i = 0; i < count; i++)
+					offsets[i + 1] += offsets[i];
+
+				adjacency.resize(result.size());
+				for (size_t i = 0; i < result.size(); i++)
+					adjacency[offsets[result[i]]++] = (uint32_t)(i / 3);
+				for (uint32_t i = count; i > 0; i--)
+					offsets[i] = offsets[i - 1];
+				offsets[0] = 0;
+
+				for (uint32_t i = 0; i < count; i++)
+					collapses[i] = i;
+				std::fill(touched.begin(), touched.end(), 0);
+
+				size_t removed = 0, applied = 0;
+				for (auto& next : candidates)
+				{
+					if (next.cost > threshold || result.size() - removed * 3 <= target_count)
+						break;
+
+					if (touched[next.from] || touched[next.to])
+						continue;
+
+					size_t degenerate = 0;
+					bool flipped = false;
+					for (uint32_t j = offsets[next.from]; j < offsets[next.from + 1] && !flipped; j++)
+					{
+						size_t triangle = (size_t)adjacency[j] * 3;
+						vector3 before[3], after[3];
+						bool shared = false;
+						for (size_t k = 0; k < 3; k++)
+						{
+							uint32_t vertex = (uint32_t)result[triangle + k];
+							before[k] = positions[vertex];
+							after[k] = (vertex == next.from ? positions[next.to] : before[k]);
+							shared = shared || vertex == next.to;
+						}
+
+						if (shared)
+						{
+							++degenerate;
+							continue;
+						}
+
+						vector3 source = (before[1] - before[0]).cross(before[2] - before[0]);
+						vector3 target = (after[1] - after[0]).cross(after[2] - after[0]);
+						flipped = source.dot(target) <= 0.0f;
+					}
+
+					if (flipped)
+						continue;
+
+					for (uint32_t j = offsets[next.from]; j < offsets[next.from + 1]; j++)
+					{
+						size_t triangle = (size_t)adjacency[j] * 3;
+						for (size_t k = 0; k < 3; k++)
+							touched[result[triangle + k]] = 1;
+					}
+
+					touched[next.to] = 1;
+					collapses[next.from] = next.to;
+					quadrics[next.to].add(quadrics[next.from]);
+					worst = std::max(worst, next.cost);
+					removed += degenerate;
+					++applied;
+				}
+
+				if (!applied)
+					break;
+
+				size_t written = 0;
+				for (size_t i = 0; i < result.size(); i += 3)
+				{
+					int a = (int)collapses[result[i + 0]], b = (int)collapses[result[i + 1]], c = (int)collapses[result[i + 2]];
+					if (a == b || b == c || a == c)
+						continue;
+
+					result[written++] = a;
+					result[written++] = b;
+					result[written++] = c;
+				}
+				result.resize(written);
+			}
+
+			if (result_error != nullptr)
+				*result_error = (float)(std::sqrt(worst) / extent);
+
+			return result;
+		}
+		void geometric::optimize_vertex_cache(core::vector<int>& indices, size_t vertex_count, size_t cache_size)
+		{
+			VI_ASSERT(indices.size() % 3 == 0, "indices should form a triangle list");
+			size_t triangle_count = indices.size() / 3;
+			if (triangle_count < 2 || !vertex_count)
+				return;
+
+			core::vector<uint32_t> offsets(vertex_count + 1, 0), adjacency(indices.size());
+			for (int index : indices)
+				++offsets[(size_t)index + 1];
+			for (size_t i = 0; i < vertex_count; i++)
+				offsets[i + 1] += offsets[i];
+
+			core::vector<uint32_t> lives(vertex_count);
+			for (size_t i = 0; i < vertex_count; i++)
+				lives[i] = offsets[i + 1] - offsets[i];
+
+			core::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < indices.size(); i++)
+				adjacency[cursors[indices[i]]++] = (uint32_t)(i / 3);
+
+			core::vector<size_t> stamps(vertex_count, 0);
+			core::vector<uint8_t> emitted(triangle_count, 0);
+			core::vector<uint32_t> dead_ends, candidates;
+			core::vector<int> result;
+			result.reserve(indices.size());
+			dead_ends.reserve(indices.size());
+
+			size_t time = cache_size + 1, cursor = 0;
+			int64_t fanning = 0;
+			while (fanning >= 0)
+			{
+				candidates.clear();
+				for (uint32_t i = offsets[(size_t)fanning]; i < offsets[(size_t)fanning + 1]; i++)
+				{
+					uint32_t triangle = adjacency[i];
+					if (emitted[triangle])
+						continue;
+
+					for (size_t j = 0; j < 3; j++)
+					{
+						uint32_t vertex = (uint32_t)indices[triangle * 3 + j];
+						result.push_back((int)vertex);
+						dead_ends.push_back(vertex);
+						candidates.push_back(vertex);
+						--lives[vertex];
+						if (time - stamps[vertex] > cache_size)
+							stamps[vertex] = time++;
+					}
+					emitted[triangle] = 1;
+				}
+
+				int64_t best = -1, priority = -1;
+				for (uint32_t vertex : candidates)
+				{
+					if (!lives[vertex])
+						continue;
+
+					int64_t next = 0;
+					if (time - stamps[vertex] + 2 * lives[vertex] <= cache_size)
+						next = (int64_t)(time - stamps[vertex]);
+
+					if (next > priority)
+					{
+						priority = next;
+						best = vertex;
+					}
+				}
+
+				while (best < 0 && !dead_ends.empty())
+				{
+					uint32_t vertex = dead_ends.back();
+					dead_ends.pop_back();
+					if (lives[vertex] > 0)
+						best = vertex;
+				}
+
+				while (best < 0 && cursor < vertex_count)
+				{
+					if (lives[cursor] > 0)
+						best = (int64_t)cursor;
+					++cursor;
+				}
+
+				fanning = best;
+			}
+
+			indices = std::move(result);
+		}
 		bool geometric::left_handed = true;
 
 		transform::transform(void* new_user_data) noexcept : root(nullptr), local(nullptr), scaling(false), dirty(true), user_data(new_user_data)
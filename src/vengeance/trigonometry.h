@@ -600,6 +600,11 @@ namespace vitex
 			void merge(const bounding&, const bounding&);
 			bool contains(const bounding&) const;
 			bool overlaps(const bounding&) const;
+			bool overlaps_sphere(const vector3& center, float radius) const;
+			bool overlaps_capsule(const vector3& start, const vector3& end, float radius) const;
+			bool overlaps_obb(const matrix4x4& world) const;
+			bool overlaps_cone(const vector3& origin, const vector3& direction, float range, float angle) const;
+			float get_distance(const vector3& point) const;
 		};
 
 		struct ray
@@ -690,6 +695,39 @@ namespace vitex
 			float rate = 1.0f;
 		};
 
+		struct skin_animator_track
+		{
+			uint32_t offset = 0;
+			uint32_t count = 0;
+		};
+
+		struct skin_animator_compressed_clip
+		{
+			core::vector<skin_animator_track> position_tracks;
+			core::vector<skin_animator_track> rotation_tracks;
+			core::vector<skin_animator_track> scale_tracks;
+			core::vector<float> position_times;
+			core::vector<float> rotation_times;
+			core::vector<float> scale_times;
+			core::vector<vector3> positions;
+			core::vector<uint64_t> rotations;
+			core::vector<vector3> scales;
+			core::vector<float> timeline;
+			core::string name;
+			float duration = 1.0f;
+			float rate = 1.0f;
+
+			void sample(float time, core::vector<animator_key>& pose) const;
+			void sample_frame(size_t frame, core::vector<animator_key>& pose) const;
+			size_t get_joints_count() const;
+			size_t get_frames_count() const;
+			size_t get_memory_usage() const;
+
+			static skin_animator_compressed_clip compress(const skin_animator_clip& clip, float position_tolerance = 0.0005f, float rotation_tolerance = 0.000002f, float scale_tolerance = 0.0005f);
+			static uint64_t pack_rotation(const quaternion& value);
+			static quaternion unpack_rotation(uint64_t value);
+		};
+
 		struct random_vector2
 		{
 			vector2 min, max;
@@ -844,6 +882,7 @@ namespace vitex
 			radix_sorter& operator =(radix_sorter&& v) noexcept;
 			radix_sorter& sort(uint32_t* input, uint32_t nb, bool signed_values = true);
 			radix_sorter& sort(float* input, uint32_t nb);
+			radix_sorter& sort(uint64_t* input, uint32_t nb);
 			radix_sorter& reset_indices();
 			uint32_t* get_indices();
 		};
@@ -880,6 +919,14 @@ namespace vitex
 			static float aabb_volume(const vector3& min, const vector3& max);
 			static float angluar_lerp(float a, float b, float delta_time);
 			static float angle_distance(float a, float b);
+			static void transform_points(const vector3* input, vector3* output, size_t count, const matrix4x4& matrix);
+			static void transform_matrices(const matrix4x4* input, matrix4x4* output, size_t count, const matrix4x4& matrix);
+			static void lerp_points(const vector3* from, const vector3* to, vector3* output, size_t count, float delta_time);
+			static void normalize_points(const vector3* input, vector3* output, size_t count);
+			static void distance_points(const vector3* input, float* output, size_t count, const vector3& point);
+			static bool reduce_bounds(const vector3* input, size_t count, vector3& min, vector3& max);
+			static core::vector<int> simplify_triangle_list(const core::vector<vector3>& positions, const core::vector<int>& indices, size_t target_count, float max_error, float* result_error = nullptr);
+			static void optimize_vertex_cache(core::vector<int>& indices, size_t vertex_count, size_t cache_size = 16);
 
 		public:
 			template <typename t>
@@ -891,6 +938,25 @@ namespace vitex
 				for (auto& item : vertices)
 					item.texcoord_y = 1.0f - item.texcoord_y;
 			}
+			template <typename t>
+			static void optimize_vertex_fetch(core::vector<t>& vertices, core::vector<int>& indices)
+			{
+				core::vector<int> remap(vertices.size(), -1);
+				core::vector<t> result;
+				result.reserve(vertices.size());
+				for (auto& index : indices)
+				{
+					VI_ASSERT(index >= 0 && (size_t)index < vertices.size(), "index outside of vertices range");
+					int& next = remap[(size_t)index];
+					if (next < 0)
+					{
+						next = (int)result.size();
+						result.push_back(vertices[(size_t)index]);
+					}
+					index = next;
+				}
+				vertices = std::move(result);
+			}
 		};
 
 		class transform final : public core::reference<transform>
@@ -971,6 +1037,7 @@ namespace vitex
 		{
 		public:
 			typedef core::vector<size_t> iterator;
+			typedef core::vector<std::pair<float, size_t>> nearest_iterator;
 
 		public:
 			struct node
@@ -1048,6 +1115,68 @@ namespace vitex
 					}
 				}
 			}
+			template <typename t, typename overlaps_function, typename visitor_function>
+			bool visit_index(iterator& context, overlaps_function&& overlaps, visitor_function&& visitor) const
+			{
+				context.clear();
+				if (!items.empty())
+					context.push_back(root);
+
+				while (!context.empty())
+				{
+					auto& next = nodes[context.back()];
+					context.pop_back();
+
+					if (!overlaps(next.bounds))
+						continue;
+
+					if (!next.is_leaf())
+					{
+						context.push_back(next.left);
+						context.push_back(next.right);
+					}
+					else if (next.item != nullptr && !visitor((t*)next.item))
+						return false;
+				}
+
+				return true;
+			}
+			template <typename t, typename distance_function>
+			size_t query_nearest(nearest_iterator& context, distance_function&& distance, size_t count, t** results, float* distances = nullptr) const
+			{
+				auto comparator = [](const std::pair<float, size_t>& a, const std::pair<float, size_t>& b) { return a.first > b.first; };
+				size_t size = 0;
+				context.clear();
+				if (items.empty() || !count || !results)
+					return size;
+
+				context.emplace_back(distance(nodes[root].bounds), root);
+				while (!context.empty() && size < count)
+				{
+					std::pop_heap(context.begin(), context.end(), comparator);
+					auto next = context.back();
+					context.pop_back();
+
+					auto& target = nodes[next.second];
+					if (target.is_leaf())
+					{
+						if (target.item != nullptr)
+						{
+							if (distances != nullptr)
+								distances[size] = next.first;
+							results[size++] = (t*)target.item;
+						}
+						continue;
+					}
+
+					context.emplace_back(distance(nodes[target.left].bounds), target.left);
+					std::push_heap(context.begin(), context.end(), comparator);
+					context.emplace_back(distance(nodes[target.right].bounds), target.right);
+					std::push_heap(context.begin(), context.end(), comparator);
+				}
+
+				return size;
+			}
 		};
 	}
 }